@@ -0,0 +1,38 @@
+#pragma once
+
+#include <array>
+#include <string_view>
+#include <cstddef>
+
+// A set of bytes that is searched for 32 (AVX2) or 16 (SSE2) bytes at a time, with a byte table when the build
+// targets neither. The vector compare handles up to MaxVectorBytes single bytes plus one ASCII range,
+// a bigger set is searched with the table only.
+class ByteScanner {
+public:
+	static constexpr size_t MaxVectorBytes{ 8 };
+
+	ByteScanner() = default;
+
+	void insert(char byte);
+	void insertRange(char first, char last);
+
+	bool contains(char byte) const {
+		return mTable[static_cast<unsigned char>(byte)];
+	}
+
+	// position of the first byte from `from` on that is (not) in the set, content.size() when there is none.
+	size_t findFirstOf(std::string_view content, size_t from) const;
+	size_t findFirstNotOf(std::string_view content, size_t from) const;
+
+private:
+	template <bool Matching>
+	size_t iFind(std::string_view content, size_t from) const;
+
+	std::array<bool, 256> mTable{};
+	std::array<char, MaxVectorBytes> mBytes{};
+	size_t mByteCount{ 0 };
+	char mRangeFirst{ 0 };
+	char mRangeLast{ 0 };
+	bool mHasRange{ false };
+	bool mVectorizable{ true };
+};
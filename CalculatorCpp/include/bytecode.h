@@ -0,0 +1,143 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <stdexcept>
+#include <unordered_map>
+#include <optional>
+#include <span>
+
+#include "nodeFactory.h"
+#include "result.h"
+#include "evaluatorScope.h"
+
+class Lambda;
+class RuntimeTypedExprComponent;
+
+// Flat postfix program of one expression tree, run on a value stack instead of walking the nodes.
+// Numeric leaves and the built-in arithmetic run without touching the evaluator map, lambda calls and
+// storages are instructions, anything else (lambda literals, constants, ...) is handed back to the tree walker.
+// Subtrees made only of numbers and built-in arithmetic are moved into number blocks that run on a bare long double stack.
+// Number blocks touch no nodes and have no side effects, so the large ones run on the TaskPool, everything else
+// (lambda calls such as := included) keeps its order on the calling thread.
+class Bytecode {
+public:
+	enum class OpCode : uint8_t {
+		PushInteger,		// operand: the number itself
+		PushNumber,			// operand: constant index
+		PushNullStorage,
+		PushArgument,		// batch programs only, pushes the column of arguments
+		PushParameter,		// operand: parameter index, pushes the number argument of the current call
+		TreeWalk,			// operand: node index, evaluate the subtree with the tree walker
+		LoadParameter,		// operand: node index of a parameter leaf, pushes the argument of the current call
+		Add,				// operand: lambda index, called when an operand isn't a number
+		Subtract,
+		Multiply,
+		Divide,
+		Power,
+		And,
+		Or,
+		SquareRoot,
+		CallInfix,			// operand: lambda index
+		CallPostfix,
+		CallPrefix,
+		MakeStorage,		// operand: element amount
+		NumberBlock,		// operand: number block index
+		Fail
+	};
+
+	struct Instruction {
+		OpCode opCode;
+		uint32_t operand;
+	};
+
+	// a number subtree is handed to the TaskPool when both operands of its operator span at least this many instructions.
+	static constexpr uint32_t ParallelMinInstructions{ 1 << 14 };
+
+	static Bytecode compile(NodeFactory::NodePos rootNodeExpression, const EvaluatorScope& EvaluatorLambdaFunctions);
+	Result<RuntimeTypedExprComponent, std::runtime_error> run(const EvaluatorScope& EvaluatorLambdaFunctions) const;
+	// whether the program can run again for a later call in EvaluatorLambdaFunctions, it then only loads the new arguments.
+	// Operators bound by a call frame are rebuilt on every call, a program calling one is compiled for that call only.
+	bool reusable(const EvaluatorScope& EvaluatorLambdaFunctions) const;
+
+	// arguments a batch program takes per column, every instruction runs over a whole column before the next one.
+	static constexpr size_t BatchColumn{ 256 };
+
+	// number block of a Number -> Number lambda made only of numbers, its parameter and built-in arithmetic,
+	// std::nullopt for any other lambda. The program holds no nodes, any thread can run it.
+	static std::optional<Bytecode> compileBatch(const Lambda& lambdaFunction, const EvaluatorScope& EvaluatorLambdaFunctions);
+	// results[ind] is the lambda evaluated at arguments[ind], with the same operations as one call of it.
+	void runBatch(std::span<const long double> arguments, std::span<long double> results) const;
+
+	// relative error a closed form sum may be estimated to have.
+	static constexpr long double ClosedFormTolerance{ 1e-12L };
+
+	// sum of a batch program over the arguments [first, last) from Faulhaber's formula and the geometric series, when the
+	// program is a polynomial of bounded degree plus geometric terms in its argument. std::nullopt for any other program and
+	// whenever the formula can't be trusted: estimated error above ClosedFormTolerance (cancellation), overflow, or
+	// disagreement with the program on the first and last terms.
+	std::optional<long double> sumClosedForm(int64_t first, int64_t last) const;
+
+private:
+	// instructions [begin, end) compute one storage element, errors inside it are reported against that element.
+	struct StorageElement {
+		uint32_t begin;
+		uint32_t end;
+		NodeFactory::NodePos argumentNode;
+	};
+
+	// instructions [begin, end) of mNumberCode, all pushes and built-in arithmetic, depth is the deepest stack they reach.
+	struct NumberBlock {
+		uint32_t begin;
+		uint32_t end;
+		uint32_t depth;
+	};
+
+	// the operator at end of mNumberCode joins the operands [begin, split) and [split, end), both large enough to run on their own.
+	struct NumberFork {
+		uint32_t begin;
+		uint32_t split;
+		uint32_t end;
+	};
+
+	// a batch program as a function of its argument k: polynomial[ind] * k^ind plus factor * ratio^k for every geometric term.
+	// Zero coefficients are trimmed, a constant has at most polynomial[0].
+	struct Series {
+		std::vector<long double> polynomial;
+		std::vector<std::pair<long double, long double>> geometric; // factor, ratio
+	};
+
+	static constexpr size_t MaxSeriesDegree{ 10 };
+	static constexpr size_t MaxGeometricTerms{ 8 };
+	static constexpr int64_t ClosedFormSampleTerms{ 16 };
+
+	std::vector<Instruction> mInstructions;
+	std::vector<long double> mConstants;
+	std::vector<NodeFactory::NodePos> mNodes;
+	std::vector<NodeFactory::NodePos> mParameters; // one parameter leaf per slot read by PushParameter.
+	NodeFactory::NodePos mRoot{ NodeFactory::NodePosNull };
+	const EvaluatorScope::Table* mTable{ nullptr };
+	bool mReusable{ true };
+	std::vector<const Lambda*> mLambdas;
+	std::vector<StorageElement> mStorageElements;
+	std::vector<Instruction> mNumberCode;
+	std::vector<NumberBlock> mNumberBlocks;
+	std::vector<NumberFork> mNumberForks; // sorted by begin, enclosing forks first.
+	std::vector<uint32_t> mParallelBlocks; // large number blocks of mInstructions, started together when there are several.
+
+	void emit(OpCode opCode, uint32_t operand = 0);
+	void emitNumber(long double number);
+	void emitTreeWalk(NodeFactory::NodePos node);
+	bool emitParameter(NodeFactory::NodePos node, const EvaluatorScope& EvaluatorLambdaFunctions);
+	void foldNumberBlocks();
+	void splitNumberBlocks();
+	std::optional<Series> series() const;
+	static std::pair<long double, long double> sumSeries(const Series& series, long double first, long double amount);
+	long double runNumberBlock(const NumberBlock& block, std::vector<long double>& numbers, const long double* parameters) const;
+	long double runNumberRange(uint32_t begin, uint32_t end, uint32_t depth, std::vector<long double>& numbers, const long double* parameters) const;
+	size_t runNumberCode(uint32_t begin, uint32_t end, long double* stack, size_t top, const long double* parameters) const;
+	std::runtime_error reportStorageElements(std::runtime_error error, size_t instructionIndex) const;
+};
+
+#include "runtimeTypedExprComponent.h"
@@ -0,0 +1,1232 @@
+#ifndef BYTECODE_IMPL_H
+#define BYTECODE_IMPL_H
+
+#include <cmath>
+#include <format>
+#include <algorithm>
+#include <optional>
+#include <limits>
+#include <deque>
+#include <memory>
+
+#include "bytecode.h"
+#include "taskPool.h"
+#include "runtimeTypedExprComponent.h"
+#include "runtime_error.h"
+
+inline void Bytecode::emit(OpCode opCode, uint32_t operand) {
+	mInstructions.emplace_back(Instruction{ opCode, operand });
+}
+
+inline void Bytecode::emitNumber(long double number) {
+	// small non-negative integers (most literals) live in the operand itself.
+	if (number >= 0 && number <= std::numeric_limits<uint32_t>::max() && !std::signbit(number) && static_cast<uint32_t>(number) == number) {
+		emit(OpCode::PushInteger, static_cast<uint32_t>(number));
+		return;
+	}
+
+	emit(OpCode::PushNumber, static_cast<uint32_t>(mConstants.size()));
+	mConstants.emplace_back(number);
+}
+
+inline void Bytecode::emitTreeWalk(NodeFactory::NodePos node) {
+	emit(OpCode::TreeWalk, static_cast<uint32_t>(mNodes.size()));
+	mNodes.emplace_back(node);
+}
+
+// arguments are read by slot on every run, a Number parameter is pushed as a number and can join a number block.
+inline bool Bytecode::emitParameter(NodeFactory::NodePos node, const EvaluatorScope& EvaluatorLambdaFunctions) {
+	const NodeFactory::Node parameterNode{ NodeFactory::node(node) };
+	if (!parameterNode.isParameter())
+		return false;
+
+	const RuntimeType* parameterType{ EvaluatorLambdaFunctions.parameterType(parameterNode.parameterSlot(), parameterNode.value()) };
+	if (!parameterType)
+		return false;
+
+	const RuntimeBaseType* baseType{ std::get_if<RuntimeBaseType>(parameterType) };
+	if (baseType && *baseType == RuntimeBaseType::Number) {
+		uint32_t parameterIndex{ 0 };
+		while (parameterIndex < mParameters.size() && NodeFactory::node(mParameters[parameterIndex]).parameterSlot() != parameterNode.parameterSlot())
+			parameterIndex++;
+		if (parameterIndex == mParameters.size())
+			mParameters.emplace_back(node);
+
+		emit(OpCode::PushParameter, parameterIndex);
+	}
+	else {
+		emit(OpCode::LoadParameter, static_cast<uint32_t>(mNodes.size()));
+		mNodes.emplace_back(node);
+	}
+	return true;
+}
+
+static Bytecode::OpCode infixOpCode(Lambda::Intrinsic intrinsic) {
+	switch (intrinsic) {
+	case Lambda::Intrinsic::Add: return Bytecode::OpCode::Add;
+	case Lambda::Intrinsic::Subtract: return Bytecode::OpCode::Subtract;
+	case Lambda::Intrinsic::Multiply: return Bytecode::OpCode::Multiply;
+	case Lambda::Intrinsic::Divide: return Bytecode::OpCode::Divide;
+	case Lambda::Intrinsic::Power: return Bytecode::OpCode::Power;
+	case Lambda::Intrinsic::And: return Bytecode::OpCode::And;
+	case Lambda::Intrinsic::Or: return Bytecode::OpCode::Or;
+	default: return Bytecode::OpCode::CallInfix;
+	}
+}
+
+inline Bytecode Bytecode::compile(NodeFactory::NodePos rootNodeExpression, const EvaluatorScope& EvaluatorLambdaFunctions) {
+	constexpr uint32_t noOperator{ std::numeric_limits<uint32_t>::max() };
+
+	Bytecode bytecode;
+	bytecode.mRoot = rootNodeExpression;
+	bytecode.mTable = &EvaluatorLambdaFunctions.table();
+	NodeFactory& factory{ NodeFactory::iGetInstance() }; // compiling creates no nodes, the columns stay put.
+
+	if (!factory.iValidNode(rootNodeExpression)) {
+		bytecode.emit(OpCode::Fail);
+		return bytecode;
+	}
+
+	// operators are looked up once per spelling instead of once per node, runs of the same operator skip the map.
+	std::unordered_map<NodeFactory::SymbolId, uint32_t> operators;
+	NodeFactory::SymbolId lastSymbol{ NodeFactory::SymbolNull };
+	uint32_t lastOperator{ noOperator };
+	auto findOperator = [&](const NodeFactory::Node& node) -> uint32_t {
+		const NodeFactory::SymbolId symbol{ node.symbol() };
+		if (symbol == lastSymbol)
+			return lastOperator;
+
+		auto operatorIt{ operators.find(symbol) };
+		if (operatorIt == operators.end()) {
+			uint32_t operatorIndex{ noOperator };
+			if (const Lambda* lambdaFunction{ EvaluatorLambdaFunctions.find(node.value()) }) {
+				operatorIndex = static_cast<uint32_t>(bytecode.mLambdas.size());
+				bytecode.mLambdas.emplace_back(lambdaFunction);
+
+				const auto tableIt{ bytecode.mTable->find(node.value()) };
+				if (tableIt == bytecode.mTable->end() || &tableIt->second != lambdaFunction)
+					bytecode.mReusable = false;
+			}
+			operatorIt = operators.emplace(symbol, operatorIndex).first;
+		}
+
+		lastSymbol = symbol;
+		lastOperator = operatorIt->second;
+		return lastOperator;
+	};
+
+	// iterative post-order, stage counts the children already compiled.
+	struct Frame {
+		NodeFactory::NodePos node;
+		uint32_t stage;
+		uint32_t operatorIndex;
+	};
+
+	// the storage being compiled, one per storage frame on the stack (innermost last).
+	struct StorageFrame {
+		NodeFactory::NodePos argumentNode;
+		uint32_t elementBegin;
+		uint32_t elementAmount;
+	};
+
+	std::vector<Frame> frames{ Frame{ rootNodeExpression, 0, noOperator } };
+	std::vector<StorageFrame> storages;
+
+	// numeric and parameter leaves are emitted right away instead of getting a frame of their own, returns whether a frame was pushed.
+	auto pushChild = [&](NodeFactory::NodePos childPos) -> bool {
+		const NodeFactory::Node child{ factory.iNode(childPos) };
+		if (child.leftPos == NodeFactory::NodePosNull && child.rightPos == NodeFactory::NodePosNull) {
+			if (child.isNumber()) {
+				bytecode.emitNumber(child.number());
+				return false;
+			}
+			if (bytecode.emitParameter(childPos, EvaluatorLambdaFunctions))
+				return false;
+		}
+
+		frames.emplace_back(Frame{ childPos, 0, noOperator });
+		return true;
+	};
+
+	while (!frames.empty()) {
+		Frame& frame{ frames.back() };
+		const NodeFactory::Node currNode{ factory.iNode(frame.node) };
+
+		if (currNode.nodestate == NodeFactory::Node::NodeState::Storage &&
+			(frame.stage || factory.iValidNode(currNode.leftPos) || factory.iValidNode(currNode.rightPos))) {
+			if (frame.stage == 0)
+				storages.emplace_back(StorageFrame{ frame.node, 0, 0 });
+			else {
+				StorageFrame& storage{ storages.back() };
+				bytecode.mStorageElements.emplace_back(StorageElement{ storage.elementBegin, static_cast<uint32_t>(bytecode.mInstructions.size()), storage.argumentNode });
+				storage.elementAmount++;
+				storage.argumentNode = factory.iNode(storage.argumentNode).rightPos;
+			}
+
+			StorageFrame& storage{ storages.back() };
+			if (!factory.iValidNode(storage.argumentNode)) {
+				bytecode.emit(OpCode::MakeStorage, storage.elementAmount);
+				storages.pop_back();
+				frames.pop_back();
+				continue;
+			}
+
+			const NodeFactory::NodePos elementNode{ factory.iNode(storage.argumentNode).leftPos };
+			storage.elementBegin = static_cast<uint32_t>(bytecode.mInstructions.size());
+			frame.stage = 1;
+
+			if (!factory.iValidNode(elementNode))
+				bytecode.emit(OpCode::Fail);
+			else
+				pushChild(elementNode);
+			continue;
+		}
+
+		if (frame.stage == 0) {
+			const bool leftValid{ factory.iValidNode(currNode.leftPos) };
+			const bool rightValid{ factory.iValidNode(currNode.rightPos) };
+
+			// if currNode is a leaf node.
+			if (!leftValid && !rightValid) {
+				if (currNode.isNumber())
+					bytecode.emitNumber(currNode.number());
+				else if (currNode.value() == "." || currNode.value() == "-.")
+					bytecode.emitNumber(0);
+				else if (currNode.nodestate == NodeFactory::Node::NodeState::Storage)
+					bytecode.emit(OpCode::PushNullStorage);
+				else if (!bytecode.emitParameter(frame.node, EvaluatorLambdaFunctions))
+					bytecode.emitTreeWalk(frame.node); // constants and unknown identifiers.
+
+				frames.pop_back();
+				continue;
+			}
+
+			const uint32_t operatorIndex{
+				(currNode.nodestate == NodeFactory::Node::NodeState::LambdaFuntion) ? noOperator : findOperator(currNode)
+			};
+
+			const Lambda::LambdaNotation notation{
+				(operatorIndex != noOperator) ? bytecode.mLambdas[operatorIndex]->getNotation() : Lambda::LambdaNotation::Constant
+			};
+
+			const bool compilable{
+				(notation == Lambda::LambdaNotation::Infix && leftValid && rightValid) ||
+				(notation == Lambda::LambdaNotation::Postfix && rightValid) ||
+				(notation == Lambda::LambdaNotation::Prefix && leftValid)
+			};
+
+			// lambda literals and malformed operators keep the tree walker's behaviour.
+			if (!compilable) {
+				bytecode.emitTreeWalk(frame.node);
+				frames.pop_back();
+				continue;
+			}
+
+			frame.operatorIndex = operatorIndex;
+		}
+
+		const size_t frameIndex{ frames.size() - 1 };
+		const uint32_t operatorIndex{ frame.operatorIndex };
+		const Lambda& lambdaFunction{ *bytecode.mLambdas[operatorIndex] };
+		const Lambda::LambdaNotation notation{ lambdaFunction.getNotation() };
+
+		// infix operands are left then right, postfix takes the right child and prefix the left one.
+		bool descended{ false };
+		while (!descended && frames[frameIndex].stage < ((notation == Lambda::LambdaNotation::Infix) ? 2u : 1u)) {
+			const uint32_t stage{ frames[frameIndex].stage++ };
+			descended = pushChild(
+				(notation == Lambda::LambdaNotation::Postfix || (notation == Lambda::LambdaNotation::Infix && stage))
+				? currNode.rightPos
+				: currNode.leftPos
+			);
+		}
+
+		if (descended)
+			continue;
+
+		if (notation == Lambda::LambdaNotation::Infix)
+			bytecode.emit(infixOpCode(lambdaFunction.getIntrinsic()), operatorIndex);
+		else if (notation == Lambda::LambdaNotation::Postfix)
+			bytecode.emit((lambdaFunction.getIntrinsic() == Lambda::Intrinsic::SquareRoot) ? OpCode::SquareRoot : OpCode::CallPostfix, operatorIndex);
+		else
+			bytecode.emit(OpCode::CallPrefix, operatorIndex);
+
+		frames.pop_back();
+	}
+
+	bytecode.foldNumberBlocks();
+	bytecode.splitNumberBlocks();
+	return bytecode;
+}
+
+inline std::optional<Bytecode> Bytecode::compileBatch(const Lambda& lambdaFunction, const EvaluatorScope& EvaluatorLambdaFunctions) {
+	Bytecode bytecode;
+
+	// of the built-in lambdas only sqrt takes and returns one Number.
+	if (!std::holds_alternative<NodeFactory::NodePos>(lambdaFunction.mLambdaFunction)) {
+		if (lambdaFunction.getIntrinsic() != Lambda::Intrinsic::SquareRoot)
+			return std::nullopt;
+
+		bytecode.mNumberCode = { Instruction{ OpCode::PushArgument, 0 }, Instruction{ OpCode::SquareRoot, 0 } };
+		bytecode.mNumberBlocks.emplace_back(NumberBlock{ 0, 2, 1 });
+		return bytecode;
+	}
+
+	const NodeFactory::NodePos lambdaNode{ std::get<NodeFactory::NodePos>(lambdaFunction.mLambdaFunction) };
+	// a body of several expressions is chained through rightPos, a call returns the last one.
+	if (!NodeFactory::validNode(lambdaNode) || NodeFactory::validNode(NodeFactory::node(lambdaNode).rightPos))
+		return std::nullopt;
+
+	const NodeFactory::ParameterList& parameters{ NodeFactory::node(lambdaNode).utilityStorage() };
+	const RuntimeBaseType* parameterType{ (parameters.size() == 1) ? std::get_if<RuntimeBaseType>(&parameters[0].second) : nullptr };
+	if (!parameterType || *parameterType != RuntimeBaseType::Number)
+		return std::nullopt;
+
+	// the body a call would run.
+	Optimizer::foldLambda(lambdaNode, EvaluatorLambdaFunctions);
+
+	// iterative post-order, opCode is the operator's instruction once its operands are queued.
+	struct Frame {
+		NodeFactory::NodePos node;
+		std::optional<OpCode> opCode;
+	};
+
+	std::vector<Frame> frames{ Frame{ NodeFactory::node(lambdaNode).leftPos, std::nullopt } };
+	while (!frames.empty()) {
+		const Frame frame{ frames.back() };
+		if (!NodeFactory::validNode(frame.node))
+			return std::nullopt;
+
+		if (frame.opCode) {
+			bytecode.emit(*frame.opCode);
+			frames.pop_back();
+			continue;
+		}
+
+		const NodeFactory::Node currNode{ NodeFactory::node(frame.node) };
+		const bool leftValid{ NodeFactory::validNode(currNode.leftPos) };
+		const bool rightValid{ NodeFactory::validNode(currNode.rightPos) };
+
+		if (!leftValid && !rightValid) {
+			if (currNode.isNumber())
+				bytecode.emitNumber(currNode.number());
+			else if (currNode.isParameter() && currNode.parameterSlot() == 0 && currNode.value() == parameters[0].first)
+				bytecode.emit(OpCode::PushArgument);
+			else
+				return std::nullopt;
+
+			frames.pop_back();
+			continue;
+		}
+
+		const Lambda* operatorFunction{
+			(currNode.nodestate == NodeFactory::Node::NodeState::Operator) ? EvaluatorLambdaFunctions.find(currNode.value()) : nullptr
+		};
+		if (!operatorFunction)
+			return std::nullopt;
+
+		if (operatorFunction->getNotation() == Lambda::LambdaNotation::Infix && leftValid && rightValid && infixOpCode(operatorFunction->getIntrinsic()) != OpCode::CallInfix) {
+			frames.back().opCode = infixOpCode(operatorFunction->getIntrinsic());
+			frames.emplace_back(Frame{ currNode.rightPos, std::nullopt });
+			frames.emplace_back(Frame{ currNode.leftPos, std::nullopt });
+		}
+		else if (operatorFunction->getIntrinsic() == Lambda::Intrinsic::SquareRoot && rightValid && !leftValid) {
+			frames.back().opCode = OpCode::SquareRoot;
+			frames.emplace_back(Frame{ currNode.rightPos, std::nullopt });
+		}
+		else
+			return std::nullopt;
+	}
+
+	uint32_t depth{ 0 }, maxDepth{ 0 };
+	for (const Instruction& instruction : bytecode.mInstructions) {
+		if (instruction.opCode == OpCode::PushInteger || instruction.opCode == OpCode::PushNumber || instruction.opCode == OpCode::PushArgument)
+			maxDepth = std::max(maxDepth, ++depth);
+		else if (instruction.opCode != OpCode::SquareRoot)
+			depth--;
+	}
+
+	// run() has nothing to do, the program is the number block.
+	bytecode.mNumberBlocks.emplace_back(NumberBlock{ 0, static_cast<uint32_t>(bytecode.mInstructions.size()), maxDepth });
+	bytecode.mNumberCode = std::move(bytecode.mInstructions);
+	bytecode.mInstructions.clear();
+	return bytecode;
+}
+
+inline void Bytecode::foldNumberBlocks() {
+	// replays the stack effect of the program, every value remembers where its instructions begin and
+	// whether they are all numeric. A numeric value consumed by anything else (or left as the result) is a maximal block.
+	struct Value {
+		uint32_t begin;
+		bool numeric;
+	};
+
+	std::vector<Value> values;
+	std::vector<std::pair<uint32_t, uint32_t>> blocks;
+
+	auto closeBlock = [&](const Value& value, uint32_t end) {
+		if (value.numeric && end - value.begin > 1) // a lone literal is already as cheap as it gets.
+			blocks.emplace_back(value.begin, end);
+	};
+
+	// the top amount values are consumed by the instruction at index, values laid out back to back end where the next one begins.
+	auto consume = [&](size_t amount, uint32_t index) -> Value {
+		const size_t first{ values.size() - amount };
+		for (size_t ind{ first }; ind < values.size(); ind++)
+			closeBlock(values[ind], (ind + 1 < values.size()) ? values[ind + 1].begin : index);
+
+		const Value result{ amount ? values[first].begin : index, false };
+		values.resize(first);
+		return result;
+	};
+
+	for (uint32_t index{ 0 }; index < static_cast<uint32_t>(mInstructions.size()); index++) {
+		const Instruction& instruction{ mInstructions[index] };
+
+		switch (instruction.opCode) {
+		case OpCode::PushInteger:
+		case OpCode::PushNumber:
+		case OpCode::PushParameter:
+			values.emplace_back(Value{ index, true });
+			break;
+
+		case OpCode::Add:
+		case OpCode::Subtract:
+		case OpCode::Multiply:
+		case OpCode::Divide:
+		case OpCode::Power:
+		case OpCode::And:
+		case OpCode::Or:
+			if (values[values.size() - 2].numeric && values.back().numeric)
+				values.pop_back();
+			else
+				values.emplace_back(consume(2, index));
+			break;
+
+		case OpCode::SquareRoot:
+			if (!values.back().numeric)
+				values.emplace_back(consume(1, index));
+			break;
+
+		case OpCode::CallInfix:
+			values.emplace_back(consume(2, index));
+			break;
+
+		case OpCode::CallPostfix:
+		case OpCode::CallPrefix:
+			values.emplace_back(consume(1, index));
+			break;
+
+		case OpCode::MakeStorage:
+			values.emplace_back(consume(instruction.operand, index));
+			break;
+
+		default: // PushNullStorage, TreeWalk and Fail stand for one value.
+			values.emplace_back(Value{ index, false });
+			break;
+		}
+	}
+	consume(values.size(), static_cast<uint32_t>(mInstructions.size()));
+
+	if (blocks.empty())
+		return;
+
+	std::ranges::sort(blocks);
+
+	auto blockDepth = [&](uint32_t begin, uint32_t end) -> uint32_t {
+		uint32_t depth{ 0 }, maxDepth{ 0 };
+		for (uint32_t index{ begin }; index < end; index++) {
+			if (mInstructions[index].opCode == OpCode::PushInteger || mInstructions[index].opCode == OpCode::PushNumber ||
+				mInstructions[index].opCode == OpCode::PushParameter)
+				maxDepth = std::max(maxDepth, ++depth);
+			else if (mInstructions[index].opCode != OpCode::SquareRoot)
+				depth--;
+		}
+		return maxDepth;
+	};
+
+	// the whole program is numeric (the usual case), hand the instructions over instead of copying them.
+	if (blocks.size() == 1 && blocks[0].first == 0 && blocks[0].second == mInstructions.size()) {
+		mNumberBlocks.emplace_back(NumberBlock{ 0, blocks[0].second, blockDepth(0, blocks[0].second) });
+		mNumberCode = std::move(mInstructions);
+		mInstructions = { Instruction{ OpCode::NumberBlock, 0 } };
+		return;
+	}
+
+	std::vector<Instruction> instructions;
+	std::vector<uint32_t> newIndex(mInstructions.size() + 1);
+	instructions.reserve(mInstructions.size());
+
+	auto blockIt{ blocks.begin() };
+	for (uint32_t index{ 0 }; index < static_cast<uint32_t>(mInstructions.size());) {
+		if (blockIt == blocks.end() || index != blockIt->first) {
+			newIndex[index] = static_cast<uint32_t>(instructions.size());
+			instructions.emplace_back(mInstructions[index++]);
+			continue;
+		}
+
+		NumberBlock block{ static_cast<uint32_t>(mNumberCode.size()), 0, blockDepth(blockIt->first, blockIt->second) };
+		for (; index < blockIt->second; index++) {
+			newIndex[index] = static_cast<uint32_t>(instructions.size());
+			mNumberCode.emplace_back(mInstructions[index]);
+		}
+		block.end = static_cast<uint32_t>(mNumberCode.size());
+
+		instructions.emplace_back(Instruction{ OpCode::NumberBlock, static_cast<uint32_t>(mNumberBlocks.size()) });
+		mNumberBlocks.emplace_back(block);
+		++blockIt;
+	}
+	newIndex.back() = static_cast<uint32_t>(instructions.size());
+
+	// blocks are whole subtrees, so a storage element either contains a block or lies outside of it.
+	for (StorageElement& element : mStorageElements) {
+		element.begin = newIndex[element.begin];
+		element.end = newIndex[element.end];
+	}
+
+	mInstructions = std::move(instructions);
+}
+
+inline void Bytecode::splitNumberBlocks() {
+	std::vector<uint32_t> begins;
+
+	for (uint32_t blockIndex{ 0 }; blockIndex < static_cast<uint32_t>(mNumberBlocks.size()); blockIndex++) {
+		const NumberBlock& block{ mNumberBlocks[blockIndex] };
+		if (block.end - block.begin < ParallelMinInstructions)
+			continue;
+		mParallelBlocks.emplace_back(blockIndex);
+
+		// two operands of the threshold and their operator, anything smaller is never split.
+		if (block.end - block.begin <= 2 * ParallelMinInstructions)
+			continue;
+
+		// replays the stack of value beginnings, an operator's operands are the two values it pops.
+		begins.clear();
+		for (uint32_t index{ block.begin }; index < block.end; index++) {
+			switch (mNumberCode[index].opCode) {
+			case OpCode::PushInteger:
+			case OpCode::PushNumber:
+			case OpCode::PushParameter:
+				begins.emplace_back(index);
+				break;
+			case OpCode::SquareRoot:
+				break;
+			default: {
+				const uint32_t split{ begins.back() };
+				begins.pop_back();
+				if (split - begins.back() >= ParallelMinInstructions && index - split >= ParallelMinInstructions)
+					mNumberForks.emplace_back(NumberFork{ begins.back(), split, index });
+				break;
+			}
+			}
+		}
+	}
+
+	if (mParallelBlocks.size() < 2)
+		mParallelBlocks.clear();
+
+	std::ranges::sort(mNumberForks, [](const NumberFork& left, const NumberFork& right) {
+		return (left.begin != right.begin) ? left.begin < right.begin : left.end > right.end;
+	});
+}
+
+inline long double Bytecode::runNumberBlock(const NumberBlock& block, std::vector<long double>& numbers, const long double* parameters) const {
+	return runNumberRange(block.begin, block.end, block.depth, numbers, parameters);
+}
+
+// the right operand of every fork in [begin, end) is spawned when its left operand starts and joined where it would have run,
+// the values and the order of every operation stay the same as on one thread.
+inline long double Bytecode::runNumberRange(uint32_t begin, uint32_t end, uint32_t depth, std::vector<long double>& numbers, const long double* parameters) const {
+	if (numbers.size() < depth)
+		numbers.resize(depth);
+
+	TaskPool& pool{ TaskPool::instance() };
+	auto forkIt{ std::ranges::lower_bound(mNumberForks, begin, {}, &NumberFork::begin) };
+	if (forkIt == mNumberForks.end() || forkIt->begin >= end || pool.workerAmount() == 0)
+		return numbers[runNumberCode(begin, end, numbers.data(), 0, parameters) - 1];
+
+	struct Joining {
+		const NumberFork* fork;
+		long double result;
+		TaskPool::Task* task;
+	};
+
+	// spawned forks, innermost last. A deque keeps the results in place for the tasks writing them.
+	std::deque<Joining> joinings;
+	TaskPool::Group forkTasks{ pool };
+
+	size_t top{ 0 };
+	for (uint32_t index{ begin }; index < end;) {
+		uint32_t stop{ end };
+		if (forkIt != mNumberForks.end() && forkIt->begin < stop)
+			stop = forkIt->begin;
+		if (!joinings.empty() && joinings.back().fork->split < stop)
+			stop = joinings.back().fork->split;
+
+		top = runNumberCode(index, stop, numbers.data(), top, parameters);
+		index = stop;
+
+		if (!joinings.empty() && index == joinings.back().fork->split) {
+			Joining& joining{ joinings.back() };
+			forkTasks.join(*joining.task);
+			numbers[top++] = joining.result;
+			index = joining.fork->end;
+			joinings.pop_back();
+
+			// forks inside the right operand were the task's.
+			while (forkIt != mNumberForks.end() && forkIt->begin < index)
+				++forkIt;
+			continue;
+		}
+
+		for (; forkIt != mNumberForks.end() && forkIt->begin == index; ++forkIt) {
+			const NumberFork* fork{ &*forkIt };
+			Joining& joining{ joinings.emplace_back(Joining{ fork, 0, nullptr }) };
+			joining.task = &forkTasks.spawn([this, fork, depth, parameters, &result = joining.result] {
+				std::vector<long double> taskNumbers;
+				result = runNumberRange(fork->split, fork->end, depth, taskNumbers, parameters);
+			});
+		}
+	}
+
+	return numbers[top - 1];
+}
+
+// runs [begin, end) on top of the values already on stack, returns the new top.
+inline size_t Bytecode::runNumberCode(uint32_t begin, uint32_t end, long double* stack, size_t top, const long double* parameters) const {
+	for (uint32_t index{ begin }; index < end; index++) {
+		const Instruction& instruction{ mNumberCode[index] };
+
+		switch (instruction.opCode) {
+		case OpCode::PushInteger:
+			stack[top++] = static_cast<long double>(instruction.operand);
+			break;
+		case OpCode::PushNumber:
+			stack[top++] = mConstants[instruction.operand];
+			break;
+		case OpCode::PushParameter:
+			stack[top++] = parameters[instruction.operand];
+			break;
+		case OpCode::Add:
+			top--;
+			stack[top - 1] += stack[top];
+			break;
+		case OpCode::Subtract:
+			top--;
+			stack[top - 1] -= stack[top];
+			break;
+		case OpCode::Multiply:
+			top--;
+			stack[top - 1] *= stack[top];
+			break;
+		case OpCode::Divide:
+			top--;
+			stack[top - 1] /= stack[top];
+			break;
+		case OpCode::Power:
+			top--;
+			stack[top - 1] = std::pow(stack[top - 1], stack[top]);
+			break;
+		case OpCode::And:
+			top--;
+			stack[top - 1] = static_cast<bool>(stack[top - 1]) && static_cast<bool>(stack[top]);
+			break;
+		case OpCode::Or:
+			top--;
+			stack[top - 1] = static_cast<bool>(stack[top - 1]) || static_cast<bool>(stack[top]);
+			break;
+		default: // SquareRoot
+			stack[top - 1] = std::sqrt(stack[top - 1]);
+			break;
+		}
+	}
+
+	return top;
+}
+
+// one instruction over columns, plain loops the compiler can vectorise where long double is a double.
+static void batchArithmetic(Bytecode::OpCode opCode, long double* left, const long double* right, size_t width) {
+	switch (opCode) {
+	case Bytecode::OpCode::Add:
+		for (size_t ind{ 0 }; ind < width; ind++)
+			left[ind] += right[ind];
+		break;
+	case Bytecode::OpCode::Subtract:
+		for (size_t ind{ 0 }; ind < width; ind++)
+			left[ind] -= right[ind];
+		break;
+	case Bytecode::OpCode::Multiply:
+		for (size_t ind{ 0 }; ind < width; ind++)
+			left[ind] *= right[ind];
+		break;
+	case Bytecode::OpCode::Divide:
+		for (size_t ind{ 0 }; ind < width; ind++)
+			left[ind] /= right[ind];
+		break;
+	case Bytecode::OpCode::And:
+		for (size_t ind{ 0 }; ind < width; ind++)
+			left[ind] = static_cast<bool>(left[ind]) && static_cast<bool>(right[ind]);
+		break;
+	case Bytecode::OpCode::Or:
+		for (size_t ind{ 0 }; ind < width; ind++)
+			left[ind] = static_cast<bool>(left[ind]) || static_cast<bool>(right[ind]);
+		break;
+	default: // Power
+		for (size_t ind{ 0 }; ind < width; ind++)
+			left[ind] = std::pow(left[ind], right[ind]);
+		break;
+	}
+}
+
+inline void Bytecode::runBatch(std::span<const long double> arguments, std::span<long double> results) const {
+	const NumberBlock& block{ mNumberBlocks.front() };
+	std::vector<long double> columns(static_cast<size_t>(block.depth) * BatchColumn);
+	auto column = [&](size_t index) { return columns.data() + index * BatchColumn; };
+
+	for (size_t first{ 0 }; first < arguments.size(); first += BatchColumn) {
+		const size_t width{ std::min(BatchColumn, arguments.size() - first) };
+		size_t top{ 0 };
+
+		for (uint32_t index{ block.begin }; index < block.end; index++) {
+			const Instruction& instruction{ mNumberCode[index] };
+
+			switch (instruction.opCode) {
+			case OpCode::PushArgument:
+				std::copy_n(arguments.data() + first, width, column(top++));
+				break;
+			case OpCode::PushInteger:
+				std::fill_n(column(top++), width, static_cast<long double>(instruction.operand));
+				break;
+			case OpCode::PushNumber:
+				std::fill_n(column(top++), width, mConstants[instruction.operand]);
+				break;
+			case OpCode::SquareRoot: {
+				long double* values{ column(top - 1) };
+				for (size_t ind{ 0 }; ind < width; ind++)
+					values[ind] = std::sqrt(values[ind]);
+				break;
+			}
+			default:
+				top--;
+				batchArithmetic(instruction.opCode, column(top - 1), column(top), width);
+				break;
+			}
+		}
+
+		std::copy_n(column(0), width, results.data() + first);
+	}
+}
+
+// the number code replayed on series instead of numbers, std::nullopt as soon as an operation leaves the supported forms.
+inline std::optional<Bytecode::Series> Bytecode::series() const {
+	auto trim = [](Series& series) {
+		while (!series.polynomial.empty() && series.polynomial.back() == 0)
+			series.polynomial.pop_back();
+		std::erase_if(series.geometric, [](const std::pair<long double, long double>& term) { return term.first == 0; });
+	};
+	auto constant = [](long double number) {
+		return number == 0 ? Series{} : Series{ { number }, {} };
+	};
+	auto isConstant = [](const Series& series) {
+		return series.polynomial.size() <= 1 && series.geometric.empty();
+	};
+	auto constantOf = [](const Series& series) {
+		return series.polynomial.empty() ? 0.0L : series.polynomial.front();
+	};
+	auto addGeometric = [](Series& series, long double factor, long double ratio) {
+		for (std::pair<long double, long double>& term : series.geometric)
+			if (term.second == ratio) {
+				term.first += factor;
+				return;
+			}
+		series.geometric.emplace_back(factor, ratio);
+	};
+	auto scale = [&](Series& series, long double factor) {
+		for (long double& coefficient : series.polynomial)
+			coefficient *= factor;
+		for (std::pair<long double, long double>& term : series.geometric)
+			term.first *= factor;
+		trim(series);
+	};
+	auto multiply = [&](Series& left, const Series& right) {
+		if (isConstant(right)) {
+			scale(left, constantOf(right));
+			return true;
+		}
+		if (isConstant(left)) {
+			const long double factor{ constantOf(left) };
+			left = right;
+			scale(left, factor);
+			return true;
+		}
+		// a polynomial times a geometric term has no closed form sum here.
+		if (left.geometric.empty() && right.geometric.empty()) {
+			if (left.polynomial.size() + right.polynomial.size() - 2 > MaxSeriesDegree)
+				return false;
+
+			std::vector<long double> product(left.polynomial.size() + right.polynomial.size() - 1);
+			for (size_t leftInd{ 0 }; leftInd < left.polynomial.size(); leftInd++)
+				for (size_t rightInd{ 0 }; rightInd < right.polynomial.size(); rightInd++)
+					product[leftInd + rightInd] += left.polynomial[leftInd] * right.polynomial[rightInd];
+			left.polynomial = std::move(product);
+			trim(left);
+			return true;
+		}
+		if (left.polynomial.empty() && right.polynomial.empty()) {
+			Series product;
+			for (const std::pair<long double, long double>& leftTerm : left.geometric)
+				for (const std::pair<long double, long double>& rightTerm : right.geometric)
+					addGeometric(product, leftTerm.first * rightTerm.first, leftTerm.second * rightTerm.second);
+			left = std::move(product);
+			trim(left);
+			return left.geometric.size() <= MaxGeometricTerms;
+		}
+		return false;
+	};
+
+	std::vector<Series> stack;
+	const NumberBlock& block{ mNumberBlocks.front() };
+	for (uint32_t index{ block.begin }; index < block.end; index++) {
+		const Instruction& instruction{ mNumberCode[index] };
+
+		switch (instruction.opCode) {
+		case OpCode::PushArgument:
+			stack.emplace_back(Series{ { 0, 1 }, {} });
+			continue;
+		case OpCode::PushInteger:
+			stack.emplace_back(constant(static_cast<long double>(instruction.operand)));
+			continue;
+		case OpCode::PushNumber:
+			stack.emplace_back(constant(mConstants[instruction.operand]));
+			continue;
+		case OpCode::SquareRoot:
+			if (!isConstant(stack.back()))
+				return std::nullopt;
+			stack.back() = constant(std::sqrt(constantOf(stack.back())));
+			continue;
+		default:
+			break;
+		}
+
+		Series right{ std::move(stack.back()) };
+		stack.pop_back();
+		Series& left{ stack.back() };
+
+		switch (instruction.opCode) {
+		case OpCode::Add:
+		case OpCode::Subtract: {
+			const long double sign{ instruction.opCode == OpCode::Add ? 1.0L : -1.0L };
+			if (left.polynomial.size() < right.polynomial.size())
+				left.polynomial.resize(right.polynomial.size());
+			for (size_t ind{ 0 }; ind < right.polynomial.size(); ind++)
+				left.polynomial[ind] += sign * right.polynomial[ind];
+			for (const std::pair<long double, long double>& term : right.geometric)
+				addGeometric(left, sign * term.first, term.second);
+			trim(left);
+			if (left.geometric.size() > MaxGeometricTerms)
+				return std::nullopt;
+			break;
+		}
+		case OpCode::Multiply:
+			if (!multiply(left, right))
+				return std::nullopt;
+			break;
+		case OpCode::Divide:
+			if (isConstant(right) && constantOf(right) != 0)
+				scale(left, 1 / constantOf(right));
+			// c / (d * r^k) is c / d * (1 / r)^k.
+			else if (isConstant(left) && right.polynomial.empty() && right.geometric.size() == 1 && right.geometric.front().second != 0)
+				left = Series{ {}, { { constantOf(left) / right.geometric.front().first, 1 / right.geometric.front().second } } };
+			else
+				return std::nullopt;
+			trim(left);
+			break;
+		case OpCode::Power:
+			if (isConstant(left) && isConstant(right)) {
+				left = constant(std::pow(constantOf(left), constantOf(right)));
+			}
+			// a series to a small natural power, multiplied out.
+			else if (isConstant(right) && constantOf(right) >= 0 && constantOf(right) <= MaxSeriesDegree
+				&& constantOf(right) == std::floor(constantOf(right))) {
+				Series power{ constant(1) };
+				for (long double exponent{ constantOf(right) }; exponent > 0; exponent--)
+					if (!multiply(power, left))
+						return std::nullopt;
+				left = std::move(power);
+			}
+			// c^(a * k + b) is c^b * (c^a)^k.
+			else if (isConstant(left) && constantOf(left) > 0 && right.geometric.empty() && right.polynomial.size() <= 2) {
+				const long double base{ constantOf(left) };
+				left = Series{ {}, { { std::pow(base, constantOf(right)), std::pow(base, right.polynomial.back()) } } };
+				trim(left);
+			}
+			else
+				return std::nullopt;
+			break;
+		default: // And, Or
+			if (!isConstant(left) || !isConstant(right))
+				return std::nullopt;
+			left = constant(instruction.opCode == OpCode::And
+				? static_cast<bool>(constantOf(left)) && static_cast<bool>(constantOf(right))
+				: static_cast<bool>(constantOf(left)) || static_cast<bool>(constantOf(right)));
+			break;
+		}
+	}
+
+	return std::move(stack.back());
+}
+
+// {sum, magnitude} of series over the arguments [first, first + amount). The magnitude bounds the intermediate values the
+// formula adds up, the rounding error of the sum is a few epsilons of it.
+inline std::pair<long double, long double> Bytecode::sumSeries(const Series& series, long double first, long double amount) {
+	// Bernoulli numbers (B1 = -1/2), sum of j^p over [0, n) is 1 / (p + 1) * sum of C(p + 1, i) * B_i * n^(p + 1 - i).
+	static constexpr long double Bernoulli[MaxSeriesDegree + 1]{
+		1.0L, -1.0L / 2, 1.0L / 6, 0.0L, -1.0L / 30, 0.0L, 1.0L / 42, 0.0L, -1.0L / 30, 0.0L, 5.0L / 66 };
+
+	const size_t size{ series.polynomial.size() };
+	std::vector<std::vector<long double>> binomial(size + 1);
+	for (size_t row{ 0 }; row <= size; row++) {
+		binomial[row].assign(row + 1, 1);
+		for (size_t ind{ 1 }; ind < row; ind++)
+			binomial[row][ind] = binomial[row - 1][ind - 1] + binomial[row - 1][ind];
+	}
+
+	// the polynomial in j = k - first, so the powers summed start at zero whatever first is.
+	std::vector<long double> shifted(size), shiftedMagnitude(size);
+	for (size_t power{ 0 }; power < size; power++)
+		for (size_t ind{ 0 }; ind <= power; ind++) {
+			const long double term{ series.polynomial[power] * binomial[power][ind] * std::pow(first, static_cast<long double>(power - ind)) };
+			shifted[ind] += term;
+			shiftedMagnitude[ind] += std::abs(term);
+		}
+
+	long double sum{ 0 };
+	long double magnitude{ 0 };
+	for (size_t power{ 0 }; power < size; power++) {
+		long double powerSum{ 0 };
+		for (size_t ind{ 0 }; ind <= power; ind++)
+			powerSum += binomial[power + 1][ind] * Bernoulli[ind] * std::pow(amount, static_cast<long double>(power + 1 - ind));
+		powerSum /= static_cast<long double>(power + 1);
+
+		sum += shifted[power] * powerSum;
+		magnitude += shiftedMagnitude[power] * std::abs(powerSum);
+	}
+
+	// (r^n - 1) / (r - 1), through expm1 so ratios close to one keep their digits.
+	auto geometricSum = [amount](long double ratio) {
+		if (ratio == 1)
+			return amount;
+		if (ratio > 0)
+			return std::expm1(amount * std::log(ratio)) / (ratio - 1);
+		return (std::pow(ratio, amount) - 1) / (ratio - 1);
+	};
+	for (const auto& [factor, ratio] : series.geometric) {
+		sum += factor * std::pow(ratio, first) * geometricSum(ratio);
+		// the error of r^n grows with the exponent n * log(r).
+		const long double growth{ ratio == 0 ? 1.0L : 1 + amount * std::abs(std::log(std::abs(ratio))) };
+		magnitude += std::abs(factor) * std::pow(std::abs(ratio), first) * geometricSum(std::abs(ratio)) * growth;
+	}
+
+	return { sum, magnitude };
+}
+
+inline std::optional<long double> Bytecode::sumClosedForm(int64_t first, int64_t last) const {
+	if (last <= first)
+		return std::nullopt;
+
+	const std::optional<Series> program{ series() };
+	if (!program)
+		return std::nullopt;
+
+	constexpr long double Epsilon{ std::numeric_limits<long double>::epsilon() };
+	const auto [sum, magnitude] { sumSeries(*program, static_cast<long double>(first), static_cast<long double>(last - first)) };
+	if (!std::isfinite(sum) || !std::isfinite(magnitude) || 64 * Epsilon * magnitude > ClosedFormTolerance * std::abs(sum))
+		return std::nullopt;
+
+	// the formula against the program itself on the first and the last terms, this catches whatever the replay got wrong.
+	const int64_t sampleAmount{ std::min(last - first, ClosedFormSampleTerms) };
+	std::vector<long double> arguments(static_cast<size_t>(sampleAmount));
+	std::vector<long double> terms(arguments.size());
+	for (const int64_t sampleFirst : { first, last - sampleAmount }) {
+		for (size_t ind{ 0 }; ind < arguments.size(); ind++)
+			arguments[ind] = static_cast<long double>(sampleFirst + static_cast<int64_t>(ind));
+		runBatch(arguments, terms);
+
+		long double termSum{ 0 };
+		long double termMagnitude{ 0 };
+		for (const long double term : terms) {
+			termSum += term;
+			termMagnitude += std::abs(term);
+		}
+
+		const auto [sampleSum, sampleMagnitude] { sumSeries(*program, static_cast<long double>(sampleFirst), static_cast<long double>(sampleAmount)) };
+		if (!(std::abs(sampleSum - termSum) <= 4 * ClosedFormSampleTerms * Epsilon * std::max(sampleMagnitude, termMagnitude)))
+			return std::nullopt;
+	}
+
+	return sum;
+}
+
+inline std::runtime_error Bytecode::reportStorageElements(std::runtime_error error, size_t instructionIndex) const {
+	// elements are recorded innermost first.
+	for (const StorageElement& element : mStorageElements) {
+		if (instructionIndex < element.begin || instructionIndex >= element.end)
+			continue;
+
+		error = RuntimeError<StorageEvaluationError>(
+			error,
+			std::format(
+				"When attempting to evaluate an argument. (value = {})",
+				NodeFactory::validNode(NodeFactory::node(element.argumentNode).leftPos)
+				? NodeFactory::node(element.argumentNode).leftNode().value()
+				: "Null"),
+			"Lambda::_NodeExpressionEvaluate"
+		);
+	}
+	return error;
+}
+
+// numbers stay unboxed until something other than the built-in arithmetic needs them.
+class BytecodeStack {
+public:
+	BytecodeStack() {
+		mKinds.reserve(16);
+		mNumbers.reserve(16);
+	}
+
+	bool empty() const {
+		return mKinds.empty();
+	}
+
+	void pushNumber(long double number) {
+		mKinds.emplace_back(Kind::Number);
+		mNumbers.emplace_back(number);
+	}
+
+	void pushComponent(RuntimeTypedExprComponent&& component) {
+		mKinds.emplace_back(Kind::Component);
+		mComponents.emplace_back(std::move(component));
+	}
+
+	// the top amount values are all unboxed numbers.
+	bool topAreNumbers(size_t amount) const {
+		if (mKinds.size() < amount)
+			return false;
+		for (size_t depth{ 0 }; depth < amount; depth++)
+			if (mKinds[mKinds.size() - 1 - depth] != Kind::Number)
+				return false;
+		return true;
+	}
+
+	// only valid when topAreNumbers(depth + 1).
+	long double& topNumber(size_t depth) {
+		return mNumbers[mNumbers.size() - 1 - depth];
+	}
+
+	// unboxed or boxed number at depth (0 is the top).
+	std::optional<long double> numberAt(size_t depth) const {
+		size_t numbersAbove{ 0 };
+		for (size_t ind{ 0 }; ind < depth; ind++)
+			numbersAbove += (mKinds[mKinds.size() - 1 - ind] == Kind::Number);
+
+		if (mKinds[mKinds.size() - 1 - depth] == Kind::Number)
+			return mNumbers[mNumbers.size() - 1 - numbersAbove];
+
+		const RuntimeTypedExprComponent& component{ mComponents[mComponents.size() - 1 - (depth - numbersAbove)] };
+		if (component.getTypeHolded() == RuntimeBaseType::Number)
+			return component.getNumber().getNumber();
+		return std::nullopt;
+	}
+
+	void popNumber() {
+		mKinds.pop_back();
+		mNumbers.pop_back();
+	}
+
+	RuntimeTypedExprComponent pop() {
+		const Kind kind{ mKinds.back() };
+		mKinds.pop_back();
+
+		if (kind == Kind::Number) {
+			const long double number{ mNumbers.back() };
+			mNumbers.pop_back();
+			return number;
+		}
+
+		RuntimeTypedExprComponent component{ std::move(mComponents.back()) };
+		mComponents.pop_back();
+		return component;
+	}
+
+private:
+	enum class Kind : uint8_t {
+		Number,
+		Component
+	};
+
+	std::vector<Kind> mKinds;
+	std::vector<long double> mNumbers;
+	std::vector<RuntimeTypedExprComponent> mComponents;
+};
+
+static long double bytecodeArithmetic(Bytecode::OpCode opCode, long double left, long double right) {
+	switch (opCode) {
+	case Bytecode::OpCode::Add: return left + right;
+	case Bytecode::OpCode::Subtract: return left - right;
+	case Bytecode::OpCode::Multiply: return left * right;
+	case Bytecode::OpCode::Divide: return left / right;
+	case Bytecode::OpCode::And: return static_cast<bool>(left) && static_cast<bool>(right);
+	case Bytecode::OpCode::Or: return static_cast<bool>(left) || static_cast<bool>(right);
+	default: return std::pow(left, right);
+	}
+}
+
+inline bool Bytecode::reusable(const EvaluatorScope& EvaluatorLambdaFunctions) const {
+	return mReusable && mTable == &EvaluatorLambdaFunctions.table();
+}
+
+inline Result<RuntimeTypedExprComponent, std::runtime_error> Bytecode::run(const EvaluatorScope& EvaluatorLambdaFunctions) const {
+	// the number arguments of this call, in the order PushParameter reads them.
+	std::vector<long double> parameters;
+	parameters.reserve(mParameters.size());
+	for (const NodeFactory::NodePos parameterNode : mParameters) {
+		const RuntimeTypedExprComponent* argument{ parameterArgument(parameterNode, EvaluatorLambdaFunctions) };
+		if (!argument || argument->getTypeHolded() != RuntimeBaseType::Number)
+			return Lambda::_NodeExpressionTreeWalk(mRoot, EvaluatorLambdaFunctions); // run against another scope than it was compiled for.
+		parameters.emplace_back(argument->getNumber().getNumber());
+	}
+
+	BytecodeStack stack;
+	std::vector<long double> numbers;
+	std::optional<Result<RuntimeTypedExprComponent, std::runtime_error>> callResult;
+
+	// several large number blocks (e.g. storage elements) don't depend on each other nor on the calls between them,
+	// they all start right away and are joined where the program reads them.
+	TaskPool& pool{ TaskPool::instance() };
+	std::vector<TaskPool::Task*> blockTasks; // null once joined.
+	std::vector<long double> blockResults;
+	TaskPool::Group blockGroup{ pool };
+
+	if (!mParallelBlocks.empty() && pool.workerAmount()) {
+		blockTasks.resize(mNumberBlocks.size());
+		blockResults.resize(mNumberBlocks.size());
+		for (const uint32_t blockIndex : mParallelBlocks) {
+			blockTasks[blockIndex] = &blockGroup.spawn([this, blockIndex, &parameters, &result = blockResults[blockIndex]] {
+				std::vector<long double> taskNumbers;
+				result = runNumberBlock(mNumberBlocks[blockIndex], taskNumbers, parameters.data());
+			});
+		}
+	}
+
+	for (size_t instructionIndex{ 0 }; instructionIndex < mInstructions.size(); instructionIndex++) {
+		const Instruction& instruction{ mInstructions[instructionIndex] };
+
+		switch (instruction.opCode) {
+		case OpCode::PushInteger:
+			stack.pushNumber(static_cast<long double>(instruction.operand));
+			continue;
+
+		case OpCode::PushNumber:
+			stack.pushNumber(mConstants[instruction.operand]);
+			continue;
+
+		case OpCode::PushParameter:
+			stack.pushNumber(parameters[instruction.operand]);
+			continue;
+
+		case OpCode::PushNullStorage:
+			stack.pushComponent(Storage::NullStorage());
+			continue;
+
+		case OpCode::NumberBlock:
+			if (!blockTasks.empty() && blockTasks[instruction.operand]) {
+				blockGroup.join(*blockTasks[instruction.operand]);
+				blockTasks[instruction.operand] = nullptr;
+				stack.pushNumber(blockResults[instruction.operand]);
+				continue;
+			}
+			stack.pushNumber(runNumberBlock(mNumberBlocks[instruction.operand], numbers, parameters.data()));
+			continue;
+
+		case OpCode::MakeStorage: {
+			std::vector<RuntimeTypedExprComponent> arguments;
+			arguments.reserve(instruction.operand);
+			for (uint32_t ind{ 0 }; ind < instruction.operand; ind++)
+				arguments.emplace_back(stack.pop());
+			std::ranges::reverse(arguments);
+
+			stack.pushComponent(Storage::fromVector(std::move(arguments)));
+			continue;
+		}
+
+		case OpCode::Fail:
+			return reportStorageElements(std::runtime_error("failed."), instructionIndex);
+
+		case OpCode::LoadParameter:
+			if (const RuntimeTypedExprComponent* argument{ parameterArgument(mNodes[instruction.operand], EvaluatorLambdaFunctions) }) {
+				stack.pushComponent(RuntimeTypedExprComponent(*argument));
+				continue;
+			}
+			[[fallthrough]]; // run against another scope than it was compiled for.
+
+		case OpCode::TreeWalk:
+			callResult.emplace(Lambda::_NodeExpressionTreeWalk(mNodes[instruction.operand], EvaluatorLambdaFunctions));
+			break;
+
+		case OpCode::SquareRoot:
+			if (const std::optional<long double> number{ stack.numberAt(0) }) {
+				stack.pop();
+				stack.pushNumber(std::sqrt(*number));
+				continue;
+			}
+			[[fallthrough]];
+
+		case OpCode::CallPostfix:
+		case OpCode::CallPrefix: {
+			RuntimeTypedExprComponent operand{ stack.pop() };
+			const Lambda& lambdaFunction{ *mLambdas[instruction.operand] };
+			callResult.emplace((instruction.opCode == OpCode::CallPrefix)
+				? Lambda::_applyPrefix(lambdaFunction, operand, EvaluatorLambdaFunctions)
+				: Lambda::_applyPostfix(lambdaFunction, operand, EvaluatorLambdaFunctions));
+			break;
+		}
+
+		default: {
+			if (instruction.opCode != OpCode::CallInfix) {
+				if (stack.topAreNumbers(2)) {
+					stack.topNumber(1) = bytecodeArithmetic(instruction.opCode, stack.topNumber(1), stack.topNumber(0));
+					stack.popNumber();
+					continue;
+				}
+
+				// boxed numbers, e.g. results of lambda calls.
+				const std::optional<long double> leftNumber{ stack.numberAt(1) };
+				const std::optional<long double> rightNumber{ stack.numberAt(0) };
+				if (leftNumber && rightNumber) {
+					stack.pop();
+					stack.pop();
+					stack.pushNumber(bytecodeArithmetic(instruction.opCode, *leftNumber, *rightNumber));
+					continue;
+				}
+			}
+
+			RuntimeTypedExprComponent rightVal{ stack.pop() };
+			RuntimeTypedExprComponent leftVal{ stack.pop() };
+			callResult.emplace(Lambda::_applyInfix(*mLambdas[instruction.operand], leftVal, rightVal, EvaluatorLambdaFunctions));
+			break;
+		}
+		}
+
+		if (callResult->isError())
+			return reportStorageElements(callResult->getException(), instructionIndex);
+		stack.pushComponent(callResult->moveValue());
+		callResult.reset();
+	}
+
+	if (stack.empty())
+		return std::runtime_error("failed.");
+
+	return stack.pop();
+}
+
+#endif // BYTECODE_IMPL_H
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <optional>
+#include <unordered_map>
+
+#include "nodeFactory.h"
+
+class Lambda;
+class RuntimeTypedExprComponent;
+
+// Lambda lookup of one evaluation: the evaluator's table plus a chain of call frames, one per lambda call.
+// A frame only points at the called lambda's parameters and arguments, so calling a lambda copies nothing.
+// Parameter references the parser resolved to slots read the innermost frame directly, by name a parameter
+// is only visible when no enclosing scope has the name (closures, lambda literals in the body).
+class EvaluatorScope {
+public:
+	using Table = std::unordered_map<std::string, Lambda>;
+	using Arguments = std::vector<RuntimeTypedExprComponent>;
+
+	// every table is a scope without frames.
+	EvaluatorScope(const Table& table);
+
+	// parameters (and arguments, when evaluating rather than typing) must outlive the frame, as must parent.
+	static EvaluatorScope frame(const EvaluatorScope& parent, const NodeFactory::ParameterList& parameters, const Arguments* arguments = nullptr);
+
+	const Lambda* find(const std::string& name) const;
+	bool contains(const std::string& name) const;
+	const Lambda& at(const std::string& name) const;
+	const Table& table() const;
+
+	// slot of the innermost frame, nullptr outside of a frame or when the slot belongs to another lambda
+	// (a parameter node spliced into a different body).
+	const RuntimeTypedExprComponent* argument(uint32_t slot, const std::string& name) const;
+	const RuntimeType* parameterType(uint32_t slot, const std::string& name) const;
+
+private:
+	bool bindsSlot(uint32_t slot, const std::string& name) const;
+
+	EvaluatorScope(const Table& table, const EvaluatorScope* parent, const NodeFactory::ParameterList* parameters, const Arguments* arguments);
+
+	const Table* mTable;
+	const EvaluatorScope* mParent;
+	const NodeFactory::ParameterList* mParameters;
+	const Arguments* mArguments;
+	mutable std::vector<std::optional<Lambda>> mParameterLambdas; // built on the first lookup by name.
+};
@@ -0,0 +1,105 @@
+#ifndef EVALUATOR_SCOPE_IMPL_H
+#define EVALUATOR_SCOPE_IMPL_H
+
+#include <format>
+#include <stdexcept>
+
+#include "evaluatorScope.h"
+#include "runtimeTypedExprComponent.h"
+
+inline EvaluatorScope::EvaluatorScope(const Table& table) :
+	mTable{ &table },
+	mParent{ nullptr },
+	mParameters{ nullptr },
+	mArguments{ nullptr } {}
+
+inline EvaluatorScope::EvaluatorScope(const Table& table, const EvaluatorScope* parent, const NodeFactory::ParameterList* parameters, const Arguments* arguments) :
+	mTable{ &table },
+	mParent{ parent },
+	mParameters{ parameters },
+	mArguments{ arguments } {}
+
+inline EvaluatorScope EvaluatorScope::frame(const EvaluatorScope& parent, const NodeFactory::ParameterList& parameters, const Arguments* arguments) {
+	return EvaluatorScope(*parent.mTable, &parent, &parameters, arguments);
+}
+
+inline const Lambda* EvaluatorScope::find(const std::string& name) const {
+	// the enclosing scopes first, the table is at the root of the chain.
+	if (mParent) {
+		if (const Lambda* lambdaFunction{ mParent->find(name) })
+			return lambdaFunction;
+	}
+	else if (const auto lambdaIt{ mTable->find(name) }; lambdaIt != mTable->end())
+		return &lambdaIt->second;
+
+	if (!mParameters)
+		return nullptr;
+
+	for (size_t ind{ 0 }; ind < mParameters->size(); ind++) {
+		if ((*mParameters)[ind].first != name)
+			continue;
+
+		if (mParameterLambdas.empty())
+			mParameterLambdas.resize(mParameters->size());
+
+		std::optional<Lambda>& parameterLambda{ mParameterLambdas[ind] };
+		if (!parameterLambda.has_value()) {
+			// a constant returning the argument, or a stand-in of the right type when only typing.
+			// the argument is copied, a lambda found here can be copied out of the frame.
+			std::optional<RuntimeTypedExprComponent> argument;
+			if (mArguments)
+				argument.emplace((*mArguments)[ind]);
+
+			Result<Lambda, std::runtime_error> constantLambda{
+				Lambda::fromFunction(
+					name,
+					RuntimeCompoundType::Lambda((*mParameters)[ind].second, RuntimeBaseType::_Storage),
+					Lambda::LambdaNotation::Constant,
+					[argument = std::move(argument)](const Lambda::LambdaArguments&) -> RuntimeTypedExprComponent {
+						if (argument.has_value())
+							return argument.value();
+						return NodeFactory::NodePosNull;
+					}
+				)
+			};
+
+			if (constantLambda.isError())
+				return nullptr;
+			parameterLambda.emplace(constantLambda.moveValue());
+		}
+		return &parameterLambda.value();
+	}
+	return nullptr;
+}
+
+inline bool EvaluatorScope::contains(const std::string& name) const {
+	return find(name) != nullptr;
+}
+
+inline const Lambda& EvaluatorScope::at(const std::string& name) const {
+	if (const Lambda* lambdaFunction{ find(name) })
+		return *lambdaFunction;
+	throw std::out_of_range(std::format("EvaluatorScope::at, \"{}\" is not bound.", name));
+}
+
+inline const EvaluatorScope::Table& EvaluatorScope::table() const {
+	return *mTable;
+}
+
+inline const RuntimeTypedExprComponent* EvaluatorScope::argument(uint32_t slot, const std::string& name) const {
+	if (!mArguments || !bindsSlot(slot, name))
+		return nullptr;
+	return &(*mArguments)[slot];
+}
+
+inline const RuntimeType* EvaluatorScope::parameterType(uint32_t slot, const std::string& name) const {
+	if (!bindsSlot(slot, name))
+		return nullptr;
+	return &(*mParameters)[slot].second;
+}
+
+inline bool EvaluatorScope::bindsSlot(uint32_t slot, const std::string& name) const {
+	return mParameters && slot < mParameters->size() && (*mParameters)[slot].first == name;
+}
+
+#endif // EVALUATOR_SCOPE_IMPL_H
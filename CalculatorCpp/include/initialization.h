@@ -8,9 +8,12 @@
 
 
 #ifndef N_LEXER
+// lexes content from `from` on, the raw string lists work as in Lexer::tokenize.
+using StaticLexer = std::function<std::vector<Token>(std::string_view content, size_t from, std::span<const RawStringSpan> knownRawStrings, std::vector<RawStringSpan>* foundRawStrings)>;
+
 void initializeLexer(Lexer& lexer);
-std::function<std::vector<std::string>(const std::string&)> initializeStaticLexer(const std::vector<std::string>& extendsKeywords);
-std::function<std::vector<std::string>(const std::string&)> initializeStaticLexer(const std::unordered_set<std::string>& extendsKeywords);
+// the main keywords plus the words of extendsKeywords, which has to outlive the lexer.
+StaticLexer initializeStaticLexer(const KeywordOverlay* extendsKeywords = nullptr);
 #endif // N_LEXER
 
 #ifndef N_PARSER
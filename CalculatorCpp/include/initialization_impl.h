@@ -3,9 +3,11 @@
 
 #include <cassert>
 #include <numbers>
+#include <algorithm>
 
 #include "initialization.h"
 #include "runtimeTypedExprComponent.h"
+#include "taskPool.h"
 
 #ifndef N_EVALUATE1
 
@@ -18,7 +20,8 @@ const Result<Lambda, std::runtime_error> addLambdaFunction = Lambda::fromFunctio
 	Lambda::LambdaNotation::Infix,																			// LambdaNotation			= Lambda::LambdaNotation::Infix
 	[](const Lambda::LambdaArguments& args) -> RuntimeTypedExprComponent {									// LambdaFunction			= ([0]: Number, [1]: Number) -> Number
 		return Number(args[0].getNumber() + args[1].getNumber());
-	}
+	},
+	Lambda::Intrinsic::Add																					// Intrinsic				= Lambda::Intrinsic::Add
 );
 
 // subtraction lambdaFunction implementation
@@ -28,7 +31,8 @@ const Result<Lambda, std::runtime_error> subtractLambdaFunction = Lambda::fromFu
 	Lambda::LambdaNotation::Infix,																			// LambdaNotation			= Lambda::LambdaNotation::Infix
 	[](const Lambda::LambdaArguments& args) -> RuntimeTypedExprComponent {									// LambdaFunction			= ([0]: Number, [1]: Number) -> Number
 		return Number(args[0].getNumber() - args[1].getNumber());
-	}
+	},
+	Lambda::Intrinsic::Subtract																				// Intrinsic				= Lambda::Intrinsic::Subtract
 );
 
 // multiplication lambdaFunction implementation
@@ -38,7 +42,8 @@ const Result<Lambda, std::runtime_error> multiplyLambdaFunction = Lambda::fromFu
 	Lambda::LambdaNotation::Infix,																			// LambdaNotation			= Lambda::LambdaNotation::Infix
 	[](const Lambda::LambdaArguments& args) -> RuntimeTypedExprComponent {									// LambdaFunction			= ([0]: Number, [1]: Number) -> Number
 		return Number(args[0].getNumber() * args[1].getNumber());
-	}
+	},
+	Lambda::Intrinsic::Multiply																				// Intrinsic				= Lambda::Intrinsic::Multiply
 );
 
 // division lambdaFunction implementation
@@ -48,7 +53,8 @@ const Result<Lambda, std::runtime_error> divideLambdaFunction = Lambda::fromFunc
 	Lambda::LambdaNotation::Infix,																			// LambdaNotation			= Lambda::LambdaNotation::Infix
 	[](const Lambda::LambdaArguments& args) -> RuntimeTypedExprComponent {									// LambdaFunction			= ([0]: Number, [1]: Number) -> Number
 		return Number(args[0].getNumber() / args[1].getNumber());
-	}
+	},
+	Lambda::Intrinsic::Divide																				// Intrinsic				= Lambda::Intrinsic::Divide
 );
 
 // power lambdaFunction implementation
@@ -58,7 +64,8 @@ const Result<Lambda, std::runtime_error> powerLambdaFunction = Lambda::fromFunct
 	Lambda::LambdaNotation::Infix,																			// LambdaNotation			= Lambda::LambdaNotation::Infix
 	[](const Lambda::LambdaArguments& args) -> RuntimeTypedExprComponent {									// LambdaFunction			= ([0]: Number, [1]: Number) -> Number
 		return Number(std::powl(args[0].getNumber(), args[1].getNumber()));
-	}
+	},
+	Lambda::Intrinsic::Power																				// Intrinsic				= Lambda::Intrinsic::Power
 );
 
 // e constant lambdaFunction implementation
@@ -78,7 +85,8 @@ const Result<Lambda, std::runtime_error> sqrtLambdaFunction = Lambda::fromFuncti
 	Lambda::LambdaNotation::Postfix,																		// LambdaNotation			= Lambda::LambdaNotation::Postfix
 	[](const Lambda::LambdaArguments& args) -> RuntimeTypedExprComponent {									// LambdaFunction			= ([0]: Number) -> Number
 		return Number(std::sqrtl(args[0].getNumber()));
-	}
+	},
+	Lambda::Intrinsic::SquareRoot																			// Intrinsic				= Lambda::Intrinsic::SquareRoot
 );
 
 // abs lambdaFunction implementation
@@ -91,6 +99,71 @@ const Result<Lambda, std::runtime_error> absLambdaFunction = Lambda::fromFunctio
 	}
 );
 
+// sigma ranges shorter than ParallelSigmaMinTerms are summed one term after the other. Longer ones of a lambda Bytecode::compileBatch
+// takes come from Bytecode::sumClosedForm when the lambda is a polynomial or geometric in its parameter, otherwise they are
+// summed in blocks of SigmaBlockTerms whose sums are added pairwise in a fixed order, so the result doesn't depend on the
+// thread amount.
+constexpr int64_t ParallelSigmaMinTerms{ 1 << 14 };
+constexpr int64_t SigmaBlockTerms{ 1 << 12 };
+
+// the terms of [first, last) through the batch program, added one after the other.
+static long double sumBatchTerms(const Bytecode& batch, int64_t first, int64_t last, std::vector<long double>& arguments, std::vector<long double>& terms) {
+	arguments.resize(static_cast<size_t>(last - first));
+	terms.resize(arguments.size());
+	for (size_t ind{ 0 }; ind < arguments.size(); ind++)
+		arguments[ind] = static_cast<long double>(first + static_cast<int64_t>(ind));
+	batch.runBatch(arguments, terms);
+
+	long double summation{ 0 };
+	for (const long double term : terms)
+		summation += term;
+	return summation;
+}
+
+// the program holds no nodes, every block is a TaskPool task. The calling thread sums the first block, then joins the
+// others in order and sums the ones no worker took yet itself.
+static long double batchSigma(const Bytecode& batch, int64_t start, int64_t stop) {
+	std::vector<long double> arguments;
+	std::vector<long double> terms;
+	if (stop - start < ParallelSigmaMinTerms)
+		return sumBatchTerms(batch, start, stop, arguments, terms);
+	if (const std::optional<long double> closedForm{ batch.sumClosedForm(start, stop) })
+		return *closedForm;
+
+	const size_t blockAmount{ static_cast<size_t>((stop - start + SigmaBlockTerms - 1) / SigmaBlockTerms) };
+	std::vector<long double> blockSums(blockAmount);
+
+	auto sumBlock = [&](size_t block, std::vector<long double>& blockArguments, std::vector<long double>& blockTerms) {
+		const int64_t first{ start + static_cast<int64_t>(block) * SigmaBlockTerms };
+		blockSums[block] = sumBatchTerms(batch, first, std::min(stop, first + SigmaBlockTerms), blockArguments, blockTerms);
+	};
+
+	TaskPool& pool{ TaskPool::instance() };
+	std::vector<TaskPool::Task*> blockTasks;
+	TaskPool::Group blockGroup{ pool };
+
+	if (pool.workerAmount())
+		for (size_t block{ 1 }; block < blockAmount; block++)
+			blockTasks.emplace_back(&blockGroup.spawn([&sumBlock, block] {
+				std::vector<long double> taskArguments;
+				std::vector<long double> taskTerms;
+				sumBlock(block, taskArguments, taskTerms);
+			}));
+
+	sumBlock(0, arguments, terms);
+	if (blockTasks.empty())
+		for (size_t block{ 1 }; block < blockAmount; block++)
+			sumBlock(block, arguments, terms);
+
+	for (TaskPool::Task* task : blockTasks)
+		blockGroup.join(*task);
+
+	for (size_t width{ 1 }; width < blockAmount; width *= 2)
+		for (size_t block{ 0 }; block + width < blockAmount; block += 2 * width)
+			blockSums[block] += blockSums[block + width];
+	return blockSums[0];
+}
+
 // summation lambdaFunction implementation
 const auto sigmaLambdaFunction = [](const std::unordered_map<Parser::Lexeme, Lambda>& EvaluatorLambdaFunction) {
 	return Lambda::fromFunction(
@@ -113,8 +186,12 @@ const auto sigmaLambdaFunction = [](const std::unordered_map<Parser::Lexeme, Lam
 			int64_t start{ static_cast<int64_t>(args[0].getStorage()[0].getNumber()) };
 			int64_t stop{ static_cast<int64_t>(args[0].getStorage()[1].getNumber()) };
 
-			long double summation{ 0 };
 			const Lambda& calcFunction{ args[1].getLambda() };
+			if (start < stop)
+				if (const std::optional<Bytecode> batch{ Bytecode::compileBatch(calcFunction, EvaluatorLambdaFunction) })
+					return Number(batchSigma(*batch, start, stop));
+
+			long double summation{ 0 };
 			for (; start < stop; start++)
 				summation += calcFunction.evaluate(EvaluatorLambdaFunction, static_cast<long double>(start)).getValue().getNumber();
 
@@ -186,7 +263,7 @@ const Result<Lambda, std::runtime_error> indexLambdaFunction = Lambda::fromFunct
 //	}
 //);
 
-static std::unordered_map<size_t, std::optional<RuntimeTypedExprComponent>> memory;
+static thread_local std::unordered_map<size_t, std::optional<RuntimeTypedExprComponent>> memory;
 const auto assignNumberFunction = [](const std::unordered_map<Parser::Lexeme, Lambda>& EvaluatorLambdaFunction) {
 	return Lambda::fromFunction(
 		":=",																										// LambdaFunctionSignature	= ":="
@@ -198,7 +275,14 @@ const auto assignNumberFunction = [](const std::unordered_map<Parser::Lexeme, La
 			if (pointedObjectResult.isError())
 				throw pointedObjectResult.getException();
 
-			memory[static_cast<size_t>(args[0].getNumber())] = pointedObjectResult.moveValue();
+			// stored values outlive the expression region, keep their nodes from being rewound.
+			// The nodes of the previous value are given back once the outermost region closes.
+			std::optional<RuntimeTypedExprComponent>& memorySlot{ memory[static_cast<size_t>(args[0].getNumber())] };
+			if (memorySlot.has_value())
+				NodeFactory::unpin(memorySlot->toNodeExpression());
+
+			memorySlot = pointedObjectResult.moveValue();
+			NodeFactory::pin(memorySlot->toNodeExpression());
 			return Number(0);
 		}
 	);
@@ -240,7 +324,8 @@ const Result<Lambda, std::runtime_error> andLambdaFunction = Lambda::fromFunctio
 	Lambda::LambdaNotation::Infix,
 	[](const Lambda::LambdaArguments& args) -> RuntimeTypedExprComponent {
 		return Number(static_cast<bool>(args[0].getNumber()) && static_cast<bool>(args[1].getNumber()));
-	}
+	},
+	Lambda::Intrinsic::And
 );
 
 const Result<Lambda, std::runtime_error> orLambdaFunction = Lambda::fromFunction(
@@ -249,15 +334,16 @@ const Result<Lambda, std::runtime_error> orLambdaFunction = Lambda::fromFunction
 	Lambda::LambdaNotation::Infix,
 	[](const Lambda::LambdaArguments& args) -> RuntimeTypedExprComponent {
 		return Number(static_cast<bool>(args[0].getNumber()) || static_cast<bool>(args[1].getNumber()));
-	}
+	},
+	Lambda::Intrinsic::Or
 );
 
 static bool isSameTree(NodeFactory::NodePos p, NodeFactory::NodePos q) {
 	if (!NodeFactory::validNode(p) && !NodeFactory::validNode(q)) return true; // Both are null
 	if (!NodeFactory::validNode(p) || !NodeFactory::validNode(q)) return false; // One is null, the other is not
 
-	const NodeFactory::Node& nodeP{ NodeFactory::node(p) };
-	const NodeFactory::Node& nodeQ{ NodeFactory::node(q) };
+	const NodeFactory::Node nodeP{ NodeFactory::node(p) };
+	const NodeFactory::Node nodeQ{ NodeFactory::node(q) };
 
 	if (nodeP != nodeQ) return false; // Values are different
 	return isSameTree(nodeP.leftPos, nodeQ.leftPos) && isSameTree(nodeP.rightPos, nodeQ.rightPos); // Recursively check left and right children
@@ -280,7 +366,7 @@ const Result<Lambda, std::runtime_error> lengthLambdaFunction = Lambda::fromFunc
 		if (!args[0].getNodePointer().isNodePointerValid())
 			return Number(0);
 
-		if (const NodeFactory::Node& pointerNode{ args[0].getNodePointer().getPointerNode() };
+		if (const NodeFactory::Node pointerNode{ args[0].getNodePointer().getPointerNode() };
 			pointerNode.nodestate == NodeFactory::Node::NodeState::LambdaFuntion ||
 			pointerNode.nodestate == NodeFactory::Node::NodeState::Storage) {
 			size_t size{ 1 };
@@ -4,13 +4,20 @@
 #include <string>
 #include <vector>
 #include <tuple>
+#include <unordered_map>
 #include <unordered_set>
+#include <string_view>
+#include <cstdint>
+#include <stack>
+#include <span>
 #include "trieTree.h"
 #include "result.h"
+#include "stringHash.h"
+#include "byteScanner.h"
 
 struct Brackets {
-	std::unordered_map<std::string, std::string> openBracketsOperators;
-	std::unordered_map<std::string, std::string> closeBracketsOperators;
+	StringMap<std::string> openBracketsOperators;
+	StringMap<std::string> closeBracketsOperators;
 
 	explicit Brackets(const std::vector<std::pair<std::string, std::string>>& pairs) {
 		for (const auto& [open, close] : pairs) {
@@ -27,6 +34,130 @@ struct LexingError {
 };
 inline const std::string LexingError::prefix = "LexingError";
 
+// one lexeme of the lexed input, as a position in it rather than a copy.
+struct Token {
+	enum class Kind : uint8_t {
+		Number,
+		Keyword,
+		RawExpression, // everything between a pair of raw string brackets.
+	};
+
+	size_t Offset;
+	size_t Length;
+	Kind TokenKind;
+
+	std::string_view text(std::string_view content) const {
+		return content.substr(Offset, Length);
+	}
+};
+
+// a raw string's content (the text between its brackets), as the lexer found it.
+// A list of them holds the raw strings of one content in the order they open, each followed by the ones nested in it.
+// The outermost count their offset from the start of the content, a nested one from the start of its parent's content,
+// so the entries nested in a raw string are the list of its own content.
+struct RawStringSpan {
+	static constexpr size_t Unclosed{ static_cast<size_t>(-1) };
+
+	size_t Offset;
+	size_t Length; // Unclosed when the input ended inside it
+	size_t NestedCount;
+};
+
+// The lexer's state machine, fed the input chunk by chunk. A lexeme or raw string cut by a chunk boundary is
+// carried over to the next chunk, the bytes before it are dropped, so only the lexeme in progress is kept in memory.
+// Token offsets count from the start of the whole input.
+class TokenStream {
+public:
+	// the words of keywordOverlay (if any) are keywords next to those of keywordTree.
+	TokenStream(
+		const TrieTree& keywordTree,
+		const KeywordOverlay* keywordOverlay,
+		const TrieTree& rawStringBracketTree,
+		const std::unordered_set<char>& separatorKeys,
+		const Brackets& rawStringBracket,
+		bool collectUnvalidPositions = false);
+
+	// appends the tokens the chunk completes, their text stays readable with text() until the next feed.
+	void feed(std::string_view chunk, std::vector<Token>& tokens);
+	// appends the tokens still pending at the end of the input.
+	void finish(std::vector<Token>& tokens);
+
+	std::string_view text(const Token& token) const;
+
+	// offsets of characters that start no keyword, when collected.
+	const std::vector<size_t>& unvalidPositions() const;
+
+private:
+	friend class Lexer;
+
+	// the lexeme being built, always a contiguous run of the content.
+	struct LexemeSpan {
+		size_t Offset{ 0 };
+		size_t Length{ 0 };
+
+		bool empty() const { return !Length; }
+		size_t back() const { return Offset + Length - 1; }
+		std::string_view text(std::string_view content) const { return content.substr(Offset, Length); }
+
+		void push(size_t ind) {
+			if (!Length)
+				Offset = ind;
+			Length++;
+		}
+
+		void append(const LexemeSpan& other) {
+			if (!Length)
+				Offset = other.Offset;
+			Length += other.Length;
+		}
+
+		void clear() { Length = 0; }
+	};
+
+	// lexes content from `from` on, spans are positions in content, which starts at mContentOffset of the input.
+	void iLex(std::string_view content, size_t from, std::vector<Token>& tokens);
+	void iFinish(std::string_view content, std::vector<Token>& tokens);
+	bool iHandleRawString(std::string_view content, size_t& ind, std::vector<Token>& tokens);
+	void iEmit(std::string_view content, const LexemeSpan& span, Token::Kind kind, std::vector<Token>& tokens);
+	void iClearBuffer(std::string_view content, std::vector<Token>& tokens);
+	bool iIsKeyword(std::string_view text) const;
+	const RawStringSpan* iKnownRawString(std::string_view content, size_t offset);
+	void iOpenRawString(size_t offset);
+	void iCloseRawString(size_t closeOffset, bool matched);
+	bool iInRawString() const {
+		return mHasTokens && (mLastOpenBracket || !mCurrentRawStrings.empty());
+	}
+
+	const TrieTree* mKeywordTree;
+	const KeywordOverlay* mKeywordOverlay;
+	const Brackets* mRawStringBracket;
+	ByteScanner mSeparators;
+	ByteScanner mBracketStarts;
+	bool mSkipDigitRuns;
+	bool mSkipSeparatorRuns;
+
+	LexemeSpan mBuff;
+	LexemeSpan mRawStringBracketBuff;
+	TrieTree::StartsWithsInstance mStartWithInst;
+	TrieTree::StartsWithsInstance mStartWithRawStringInst;
+	std::stack<std::string_view> mCurrentRawStrings; // open brackets of the raw strings, viewing the bracket table.
+
+	// the last token, as far as the raw string handling needs it.
+	bool mHasTokens{ false };
+	const std::pair<const std::string, std::string>* mLastOpenBracket{ nullptr };
+
+	std::span<const RawStringSpan> mKnownRawStrings;
+	size_t mNextKnownRawString{ 0 };
+	std::vector<RawStringSpan>* mFoundRawStrings{ nullptr };
+	std::vector<size_t> mOpenRawStrings; // entries of mFoundRawStrings still open, mirrors mCurrentRawStrings
+	bool mMismatchedRawString{ false }; // a close bracket closed a raw string of another kind, the nesting is unreliable
+
+	std::string mWindow; // the carried lexeme plus the current chunk, when fed.
+	size_t mContentOffset{ 0 };
+	bool mCollectUnvalidPositions;
+	std::vector<size_t> mUnvalidPositions;
+};
+
 class Lexer
 {
 private:
@@ -44,6 +175,31 @@ public:
 	void addRawStringBracket(const std::string& openRawStringBracket, const std::string& closeRawStringBracket);
 	void setRawStringBrackets(const std::vector <std::pair<std::string, std::string>>& RawStringBracketPairs);
 	const TrieTree& getKeywordTree() const;
+
+	// tokens point into currContent, which has to outlive them.
+	static std::vector<Token> tokenize(
+		const TrieTree& keywordTree,
+		const TrieTree& rawStringBracketTree,
+		const std::unordered_set<char>& separatorKeys,
+		const Brackets& rawStringBracket,
+		std::string_view currContent);
+	// lexes currContent from `from` on, with the words of keywordOverlay (if any) as further keywords.
+	// the raw strings listed in knownRawStrings by an earlier lex of currContent are skipped in one step,
+	// when there are none the raw strings found are listed in foundRawStrings (if given).
+	static std::vector<Token> tokenize(
+		const TrieTree& keywordTree,
+		const KeywordOverlay* keywordOverlay,
+		const TrieTree& rawStringBracketTree,
+		const std::unordered_set<char>& separatorKeys,
+		const Brackets& rawStringBracket,
+		std::string_view currContent,
+		size_t from,
+		std::span<const RawStringSpan> knownRawStrings,
+		std::vector<RawStringSpan>* foundRawStrings);
+	// the raw strings of currContent are listed in rawStrings, when given.
+	Result<std::vector<Token>, std::runtime_error> tokenize(std::string_view currContent, bool throwError = false, std::vector<RawStringSpan>* rawStrings = nullptr) const;
+
+	// copies every token into its own string.
 	static std::vector<std::string> lexing(
 		const TrieTree& keywordTree,
 		const TrieTree& rawStringBracketTree,
@@ -54,4 +210,7 @@ public:
 
 	void _addKeyword_not_reinitializeKeyWordTree(const std::string& keyword);
 	void _reinitializeKeyWordTree();
+
+	// for input that doesn't fit in memory at once, see TokenStream.
+	TokenStream tokenStream(bool collectUnvalidPositions = false) const;
 };
\ No newline at end of file
@@ -2,17 +2,32 @@
 
 #include <vector>
 #include <string>
+#include <string_view>
 #include <limits>
 #include <tuple>
 #include <cstdint>
+#include <unordered_map>
+#include <span>
+#include <memory>
 
 #include "runtimeType.h"
+#include "stringHash.h"
+
+class Bytecode;
 
 class NodeFactory {
 public:
-	using NodePos = uint32_t;
-	static const NodePos NodePosNull = std::numeric_limits<NodePos>::max();
+	// NodePos is a generation-tagged handle: low 32 bits hold the slot index, high 32 bits hold the slot generation.
+	// A handle whose generation doesn't match its slot is stale (the slot was released and possibly reused).
+	using NodePos = uint64_t;
+	using Generation = uint32_t;
+	using SymbolId = uint32_t;
+	using ParameterList = std::vector<std::pair<std::string, RuntimeType>>;
+	static constexpr NodePos NodePosNull = std::numeric_limits<NodePos>::max();
+	static constexpr SymbolId SymbolNull = std::numeric_limits<SymbolId>::max();
 
+	// Lightweight view of one slot, the node data itself lives in the factory columns (structure of arrays).
+	// Like a reference into the factory, a Node must not be kept across NodeFactory::create.
 	class Node
 	{
 	public:
@@ -24,38 +39,259 @@ public:
 			Operator,
 		};
 
-		std::string value;
-		NodeState nodestate{ NodeState::Number };
-		std::vector<std::pair<std::string, RuntimeType>> utilityStorage;
+		NodeState& nodestate;
+		NodePos& leftPos;
+		NodePos& rightPos;
+
+		const std::string& value() const;
+		void setValue(const std::string& value);
+		SymbolId symbol() const;
+
+		// pre-parsed payload, only meaningful when isNumber().
+		bool isNumber() const;
+		long double number() const;
+
+		// turns the node into a computed number leaf (constant folding), its children are dropped.
+		void setNumber(long double number);
+
+		// a lambda parameter reference resolved by the parser, the slot indexes the enclosing lambda's parameter list.
+		bool isParameter() const;
+		uint32_t parameterSlot() const;
+		void setParameterSlot(uint32_t slot);
+
+		// lambda parameter list (side table, empty for every other node).
+		const ParameterList& utilityStorage() const;
+		void setUtilityStorage(const ParameterList& parameters);
 
-		NodePos leftPos{ std::numeric_limits<NodePos>::max() };
-		NodePos rightPos{ std::numeric_limits<NodePos>::max() };
+		// set once the lambda body under this node went through the optimizer.
+		bool isFolded() const;
+		void setFolded();
 
-		explicit Node(const std::string& value);
-		Node& rightNode();
-		Node& leftNode();
+		// program of the lambda body under this node (side table), nullptr until a call compiled one.
+		// Dropped when the slot is released, the body is rewritten or the nodes move to another factory.
+		std::shared_ptr<const Bytecode> program() const;
+		void setProgram(std::shared_ptr<const Bytecode> program);
+		void clearProgram();
+
+		// type annotation of getReturnType (side table), nullptr until the node is typed.
+		// Dropped when the slot is released or the node gets a new value.
+		const RuntimeType* type() const;
+		void setType(const RuntimeType& type);
+		void clearType();
+
+		Node rightNode() const;
+		Node leftNode() const;
 
 		bool operator==(const Node& other) const;
+
+	private:
+		Node(NodeFactory& factory, uint32_t slotIndex);
+		NodeFactory& mFactory;
+		uint32_t mSlotIndex;
+		friend class NodeFactory;
+	};
+
+	// Marker of an allocation point, every node created after mark() can be given back with rewind().
+	class Region {
+	private:
+		size_t mSizeMark{ 0 };
+		size_t mReusedMark{ 0 };
+		friend class NodeFactory;
+	};
+
+	// RAII region, rewind on destruction (per-expression scope).
+	class ScopedRegion {
+	private:
+		Region mRegion;
+
+	public:
+		ScopedRegion();
+		~ScopedRegion();
+		ScopedRegion(const ScopedRegion& other) = delete;
+		ScopedRegion& operator=(const ScopedRegion& other) = delete;
+	};
+
+	// RAII context switch, the static API of the calling thread targets factory until destruction.
+	// Handles are only meaningful for the factory that created them.
+	class Scope {
+	private:
+		NodeFactory* mPrevious;
+
+	public:
+		explicit Scope(NodeFactory& factory);
+		~Scope();
+		Scope(const Scope& other) = delete;
+		Scope& operator=(const Scope& other) = delete;
 	};
 
 private:
-	NodeFactory() = default;
-	std::vector<Node> mNodeData;
+	enum NodeFlag : uint8_t {
+		Free = 1 << 0,
+		Pinned = 1 << 1,
+		Numeric = 1 << 2,
+		HasParameters = 1 << 3,
+		Folded = 1 << 4,
+		Parameter = 1 << 5,
+		Typed = 1 << 6,
+		Compiled = 1 << 7,
+	};
+
+	// node columns, indexed by slot.
+	std::vector<Node::NodeState> mStates;
+	std::vector<NodePos> mLeftPos;
+	std::vector<NodePos> mRightPos;
+	std::vector<SymbolId> mSymbols;
+	std::vector<long double> mNumbers;
+	std::vector<Generation> mGenerations;
+	std::vector<uint8_t> mFlags;
+	std::unordered_map<uint32_t, ParameterList> mParameters;
+	std::unordered_map<uint32_t, RuntimeType> mTypes;
+	std::unordered_map<uint32_t, std::shared_ptr<const Bytecode>> mPrograms;
+
+	// interned node values, counted per slot using them. A symbol no slot uses anymore is dropped when the outermost
+	// region closes and its id is handed out again, so a symbol id is only stable while a region is open.
+	std::vector<std::string> mSymbolText;
+	std::vector<long double> mSymbolNumber;
+	std::vector<bool> mSymbolIsNumber;
+	std::vector<uint32_t> mSymbolUses;
+	StringMap<SymbolId> mSymbolIds;
+	std::vector<SymbolId> mUnusedSymbols; // symbols whose use count reached zero, checked by iReleaseSymbols.
+	std::vector<SymbolId> mFreeSymbols;
+
+	std::vector<uint32_t> mFreeList;
+	std::vector<uint32_t> mRegionReused; // free-list slots handed out while a region is open.
+	std::vector<NodePos> mPinnedRoots; // one entry per pin.
+	std::vector<NodePos> mUnpinnedRoots; // trees waiting for iReleaseUnpinned.
+	size_t mOpenRegions{ 0 };
+	Generation mGenerationFloor{ 0 };
+
+	inline static thread_local NodeFactory* mCurrentInstance{ nullptr }; // null until a Scope is opened on the thread.
+	static NodeFactory& iDefaultInstance();
 
 public:
+	// every thread starts with its own default factory, so evaluators on different threads share no nodes.
+	NodeFactory() = default;
 	NodeFactory(const NodeFactory& other) = delete;
 	NodeFactory& operator=(const NodeFactory& other) = delete;
-	static NodeFactory& iGetInstance();
-	static Node& node(NodePos index);
-	static NodePos create(const std::string& value = "");
+	static NodeFactory& iGetInstance() {
+		return mCurrentInstance ? *mCurrentInstance : iDefaultInstance();
+	}
+
+	static Node node(NodePos index);
+	static NodePos create(std::string_view value = "");
+	static NodePos createNumber(long double number);
 	static void freeAll();
 	static bool validNode(NodePos index);
 	static void reserve(size_t amount);
 	static size_t size();
+	static size_t capacity(); // slots the columns hold before they grow
+	static size_t liveSize();
+	static void clearTypes();
+
+	// arena
+	static Region mark();
+	static void rewind(const Region& region);
+	// closes a region and keeps its nodes, a region around it can still give them back.
+	static void keep(const Region& region);
+	// moves the nodes of every source behind the nodes of this thread's factory, a thread copies each source.
+	// the sources are left empty, handles[ind] are handles of sources[ind] and are relocated in place.
+	static void adopt(std::span<NodeFactory* const> sources, std::span<std::vector<NodePos>> handles);
+	static void release(NodePos index);
+	// a pinned tree survives rewinds until it is unpinned as often as it was pinned. Its nodes no other pinned tree
+	// reaches are then given back when the outermost region closes (right away when none is open), the expression
+	// running meanwhile may still hold values that refer to them.
+	static void pin(NodePos root);
+	static void unpin(NodePos root);
+	static NodePos handle(size_t slotIndex);
+
+	static uint32_t slotOf(NodePos index) {
+		return static_cast<uint32_t>(index);
+	}
+
+	static Generation generationOf(NodePos index) {
+		return static_cast<Generation>(index >> 32);
+	}
 
 private:
-	Node& iNode(NodePos index);
-	NodePos iCreate(const std::string& value);
+	static NodePos makeHandle(uint32_t slotIndex, Generation generation) {
+		return (static_cast<NodePos>(generation) << 32) | slotIndex;
+	}
+
+	Node iNode(NodePos index);
+	NodePos iCreate(SymbolId symbol, long double number, bool isNumber);
+	SymbolId iIntern(std::string_view value);
+	void iUseSymbol(SymbolId symbol);
+	void iDropSymbol(uint32_t slotIndex);
+	void iReleaseSymbols();
+	void iSetSymbol(uint32_t slotIndex, SymbolId symbol);
 	bool iValidNode(NodePos index) const;
 	void iFreeAll();
+	void iReleaseSlot(uint32_t slotIndex);
+	void iClearType(uint32_t slotIndex);
+	void iClearProgram(uint32_t slotIndex);
+	void iPopSlot();
+	void iRewind(const Region& region);
+	void iKeep(const Region& region);
+	void iAdopt(std::span<NodeFactory* const> sources, std::span<std::vector<NodePos>> handles);
+	void iCopySlots(const NodeFactory& source, size_t offset, const std::vector<SymbolId>& symbols);
+	NodePos iRelocate(const NodeFactory& source, size_t offset, NodePos index) const;
+	void iSetPinned(NodePos root, bool pinned);
+	void iReleaseTree(NodePos root);
+	void iReleaseUnpinned();
+
+	friend class Bytecode;
 };
+
+// per-node accessors are inline, every tree walk goes through them.
+inline NodeFactory::Node::Node(NodeFactory& factory, uint32_t slotIndex) :
+	nodestate{ factory.mStates[slotIndex] },
+	leftPos{ factory.mLeftPos[slotIndex] },
+	rightPos{ factory.mRightPos[slotIndex] },
+	mFactory{ factory },
+	mSlotIndex{ slotIndex } {}
+
+inline NodeFactory::SymbolId NodeFactory::Node::symbol() const {
+	if (mFactory.mSymbols[mSlotIndex] == SymbolNull)
+		value(); // make sure a computed number got its symbol.
+	return mFactory.mSymbols[mSlotIndex];
+}
+
+inline bool NodeFactory::Node::isNumber() const {
+	return mFactory.mFlags[mSlotIndex] & NodeFlag::Numeric;
+}
+
+inline long double NodeFactory::Node::number() const {
+	return mFactory.mNumbers[mSlotIndex];
+}
+
+inline bool NodeFactory::Node::isParameter() const {
+	return mFactory.mFlags[mSlotIndex] & NodeFlag::Parameter;
+}
+
+// parameter nodes are never numeric, the slot lives in the number column.
+inline uint32_t NodeFactory::Node::parameterSlot() const {
+	return static_cast<uint32_t>(mFactory.mNumbers[mSlotIndex]);
+}
+
+inline const RuntimeType* NodeFactory::Node::type() const {
+	if (!(mFactory.mFlags[mSlotIndex] & NodeFlag::Typed))
+		return nullptr;
+	return &mFactory.mTypes.find(mSlotIndex)->second;
+}
+
+inline NodeFactory::Node NodeFactory::iNode(NodePos index) {
+	return Node(*this, slotOf(index));
+}
+
+inline bool NodeFactory::iValidNode(NodePos index) const {
+	const uint32_t slotIndex{ slotOf(index) };
+	return (index != NodePosNull && slotIndex < mStates.size() && mGenerations[slotIndex] == generationOf(index));
+}
+
+inline NodeFactory::Node NodeFactory::node(NodePos index) {
+	return iGetInstance().iNode(index);
+}
+
+inline bool NodeFactory::validNode(NodePos index) {
+	return iGetInstance().iValidNode(index);
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <array>
+#include <charconv>
+#include <cfloat>
+#include <cctype>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+// conversions between number literals and long double that don't go through the C locale
+// (std::stold and std::to_string do, for every call).
+
+// the number the whole text spells, std::nullopt when it is no number literal. A literal is what the lexer reads
+// as a number: an optional '-', then a digit or '.'. std::from_chars also takes "nan" and "inf", here they are identifiers.
+inline std::optional<long double> parseNumberLiteral(std::string_view text) {
+	const size_t first{ (!text.empty() && text.front() == '-') ? size_t{ 1 } : 0 };
+	if (first == text.size() || !(std::isdigit(static_cast<unsigned char>(text[first])) || text[first] == '.'))
+		return std::nullopt;
+
+	long double number{ 0 };
+	const char* const last{ text.data() + text.size() };
+	const auto [parsedEnd, errorCode] { std::from_chars(text.data(), last, number) };
+	if (errorCode != std::errc() || parsedEnd != last)
+		return std::nullopt;
+	return number;
+}
+
+// the number at the start of text in std::from_chars' format, std::invalid_argument when there is none (with std::stold's message).
+// Unlike std::stold it skips no leading whitespace, takes no '+' sign and reads no hex floats. Like it, "nan" and "inf" are numbers.
+inline long double parseNumberPrefix(std::string_view text) {
+	long double number{ 0 };
+	const auto [parsedEnd, errorCode] { std::from_chars(text.data(), text.data() + text.size(), number) };
+	if (errorCode == std::errc::invalid_argument)
+		throw std::invalid_argument("stold");
+	if (errorCode == std::errc::result_out_of_range)
+		throw std::out_of_range("stold");
+	return number;
+}
+
+// fixed notation with 6 decimals, the text std::to_string writes.
+inline std::string formatNumber(long double number) {
+	std::array<char, 64> shortBuffer;
+	if (const auto [last, errorCode] { std::to_chars(shortBuffer.data(), shortBuffer.data() + shortBuffer.size(), number, std::chars_format::fixed, 6) }; errorCode == std::errc())
+		return std::string(shortBuffer.data(), last);
+
+	// only huge magnitudes get here, every digit before the point is written out.
+	std::string longBuffer(LDBL_MAX_10_EXP + 16, '\0');
+	const auto [last, _] { std::to_chars(longBuffer.data(), longBuffer.data() + longBuffer.size(), number, std::chars_format::fixed, 6) };
+	longBuffer.resize(static_cast<size_t>(last - longBuffer.data()));
+	return longBuffer;
+}
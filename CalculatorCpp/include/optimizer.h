@@ -0,0 +1,27 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+
+#include "nodeFactory.h"
+#include "evaluatorScope.h"
+
+class Lambda;
+
+// Rewrites operator trees in place before they are evaluated: constant subtrees of built-in arithmetic become
+// a single number node and exact identities (x * 1, x / 1, x ^ 1, x - 0) drop the operator.
+// Only operators tagged with a Lambda::Intrinsic are touched, every other node is left as the parser built it.
+class Optimizer {
+public:
+	// folds a lambda body once, the result is cached on the lambda node and later calls return right away.
+	static void foldLambda(NodeFactory::NodePos lambdaNode, const EvaluatorScope& EvaluatorLambdaFunctions);
+
+	// returns the node that now stands for rootNodeExpression (an identity can drop the root itself).
+	static NodeFactory::NodePos fold(
+		NodeFactory::NodePos rootNodeExpression,
+		const EvaluatorScope& EvaluatorLambdaFunctions,
+		const NodeFactory::ParameterList& parameters = {}
+	);
+};
+
+#include "runtimeTypedExprComponent.h"
@@ -0,0 +1,192 @@
+#ifndef OPTIMIZER_IMPL_H
+#define OPTIMIZER_IMPL_H
+
+#include <cmath>
+#include <vector>
+#include <unordered_map>
+
+#include "optimizer.h"
+#include "runtimeTypedExprComponent.h"
+
+inline void Optimizer::foldLambda(NodeFactory::NodePos lambdaNode, const EvaluatorScope& EvaluatorLambdaFunctions) {
+	if (!NodeFactory::validNode(lambdaNode) || NodeFactory::node(lambdaNode).isFolded())
+		return;
+
+	NodeFactory::node(lambdaNode).setFolded();
+	fold(lambdaNode, EvaluatorLambdaFunctions, NodeFactory::node(lambdaNode).utilityStorage());
+}
+
+static long double foldArithmetic(Lambda::Intrinsic intrinsic, long double left, long double right) {
+	switch (intrinsic) {
+	case Lambda::Intrinsic::Add: return left + right;
+	case Lambda::Intrinsic::Subtract: return left - right;
+	case Lambda::Intrinsic::Multiply: return left * right;
+	case Lambda::Intrinsic::Divide: return left / right;
+	case Lambda::Intrinsic::And: return static_cast<bool>(left) && static_cast<bool>(right);
+	case Lambda::Intrinsic::Or: return static_cast<bool>(left) || static_cast<bool>(right);
+	default: return std::pow(left, right);
+	}
+}
+
+inline NodeFactory::NodePos Optimizer::fold(
+	NodeFactory::NodePos rootNodeExpression,
+	const EvaluatorScope& EvaluatorLambdaFunctions,
+	const NodeFactory::ParameterList& parameters
+) {
+	if (!NodeFactory::validNode(rootNodeExpression))
+		return rootNodeExpression;
+
+	// the intrinsic behind an operator node, looked up once per spelling.
+	std::unordered_map<NodeFactory::SymbolId, const Lambda*> intrinsics;
+	auto findIntrinsic = [&](NodeFactory::NodePos nodePos) -> const Lambda* {
+		const NodeFactory::Node currNode{ NodeFactory::node(nodePos) };
+		if (currNode.nodestate != NodeFactory::Node::NodeState::Operator)
+			return nullptr;
+
+		auto intrinsicIt{ intrinsics.find(currNode.symbol()) };
+		if (intrinsicIt == intrinsics.end()) {
+			const Lambda* lambdaFunction{ EvaluatorLambdaFunctions.find(currNode.value()) };
+			if (lambdaFunction && lambdaFunction->getIntrinsic() == Lambda::Intrinsic::None)
+				lambdaFunction = nullptr;
+			intrinsicIt = intrinsics.emplace(currNode.symbol(), lambdaFunction).first;
+		}
+		return intrinsicIt->second;
+	};
+
+	auto isNumberLeaf = [](NodeFactory::NodePos nodePos) {
+		const NodeFactory::Node currNode{ NodeFactory::node(nodePos) };
+		return currNode.isNumber() && !NodeFactory::validNode(currNode.leftPos) && !NodeFactory::validNode(currNode.rightPos);
+	};
+
+	auto isLiteral = [&](NodeFactory::NodePos nodePos, long double number) {
+		return isNumberLeaf(nodePos) && NodeFactory::node(nodePos).number() == number && !std::signbit(NodeFactory::node(nodePos).number());
+	};
+
+	// whether the subtree can only evaluate to a Number, identities must not hide the type error of anything else.
+	auto isNumberTyped = [&](NodeFactory::NodePos nodePos) {
+		if (isNumberLeaf(nodePos) || findIntrinsic(nodePos))
+			return true;
+
+		const NodeFactory::Node currNode{ NodeFactory::node(nodePos) };
+		if (NodeFactory::validNode(currNode.leftPos) || NodeFactory::validNode(currNode.rightPos))
+			return false;
+
+		// parameters resolved by the parser evaluate to their argument, which has the declared type.
+		if (!currNode.isParameter() || currNode.parameterSlot() >= parameters.size() || parameters[currNode.parameterSlot()].first != currNode.value())
+			return false;
+
+		const RuntimeBaseType* baseType{ std::get_if<RuntimeBaseType>(&parameters[currNode.parameterSlot()].second) };
+		return baseType && *baseType == RuntimeBaseType::Number;
+	};
+
+	// returns the node that replaces nodePos, its children are already folded.
+	auto simplify = [&](NodeFactory::NodePos nodePos) -> NodeFactory::NodePos {
+		const Lambda* lambdaFunction{ findIntrinsic(nodePos) };
+		if (!lambdaFunction)
+			return nodePos;
+
+		NodeFactory::Node currNode{ NodeFactory::node(nodePos) };
+		const Lambda::Intrinsic intrinsic{ lambdaFunction->getIntrinsic() };
+		const bool leftValid{ NodeFactory::validNode(currNode.leftPos) };
+		const bool rightValid{ NodeFactory::validNode(currNode.rightPos) };
+
+		if (lambdaFunction->getNotation() != Lambda::LambdaNotation::Infix) {
+			const NodeFactory::NodePos operand{ (lambdaFunction->getNotation() == Lambda::LambdaNotation::Postfix) ? currNode.rightPos : currNode.leftPos };
+			if (intrinsic == Lambda::Intrinsic::SquareRoot && NodeFactory::validNode(operand) && isNumberLeaf(operand))
+				currNode.setNumber(std::sqrt(NodeFactory::node(operand).number()));
+			return nodePos;
+		}
+
+		if (!leftValid || !rightValid)
+			return nodePos;
+
+		const NodeFactory::NodePos leftPos{ currNode.leftPos };
+		const NodeFactory::NodePos rightPos{ currNode.rightPos };
+
+		if (isNumberLeaf(leftPos) && isNumberLeaf(rightPos)) {
+			currNode.setNumber(foldArithmetic(intrinsic, NodeFactory::node(leftPos).number(), NodeFactory::node(rightPos).number()));
+			return nodePos;
+		}
+
+		// x + 0 is left alone, it turns -0 into 0.
+		switch (intrinsic) {
+		case Lambda::Intrinsic::Multiply:
+			if (isLiteral(rightPos, 1) && isNumberTyped(leftPos))
+				return leftPos;
+			if (isLiteral(leftPos, 1) && isNumberTyped(rightPos))
+				return rightPos;
+			break;
+		case Lambda::Intrinsic::Divide:
+		case Lambda::Intrinsic::Power:
+			if (isLiteral(rightPos, 1) && isNumberTyped(leftPos))
+				return leftPos;
+			break;
+		case Lambda::Intrinsic::Subtract:
+			if (isLiteral(rightPos, 0) && isNumberTyped(leftPos))
+				return leftPos;
+			break;
+		default:
+			break;
+		}
+		return nodePos;
+	};
+
+	// iterative post-order, results holds the replacement of every finished child (left before right).
+	struct Frame {
+		NodeFactory::NodePos node;
+		bool expanded;
+	};
+
+	// outside of an operator a bare identifier is read as a lambda value, not as its result, so it can't replace the operand there.
+	// parameters are the exception, they stand for their argument everywhere.
+	auto isIdentifierLeaf = [](NodeFactory::NodePos nodePos) {
+		const NodeFactory::Node currNode{ NodeFactory::node(nodePos) };
+		return currNode.nodestate == NodeFactory::Node::NodeState::Operator && !currNode.isParameter() &&
+			!NodeFactory::validNode(currNode.leftPos) && !NodeFactory::validNode(currNode.rightPos);
+	};
+
+	std::vector<Frame> frames{ Frame{ rootNodeExpression, false } };
+	std::vector<NodeFactory::NodePos> results;
+
+	while (!frames.empty()) {
+		const NodeFactory::NodePos currNodePos{ frames.back().node };
+		NodeFactory::Node currNode{ NodeFactory::node(currNodePos) };
+
+		if (!frames.back().expanded) {
+			frames.back().expanded = true;
+
+			// nested lambdas are folded when they are evaluated themselves.
+			if (currNode.nodestate == NodeFactory::Node::NodeState::LambdaFuntion && currNodePos != rootNodeExpression) {
+				results.emplace_back(currNodePos);
+				frames.pop_back();
+				continue;
+			}
+
+			if (NodeFactory::validNode(currNode.rightPos))
+				frames.emplace_back(Frame{ currNode.rightPos, false });
+			if (NodeFactory::validNode(currNode.leftPos))
+				frames.emplace_back(Frame{ currNode.leftPos, false });
+			continue;
+		}
+
+		const bool operatorParent{ currNode.nodestate == NodeFactory::Node::NodeState::Operator };
+		auto adopt = [&](NodeFactory::NodePos child) {
+			const NodeFactory::NodePos replacement{ results.back() };
+			results.pop_back();
+
+			return (operatorParent || !isIdentifierLeaf(replacement)) ? replacement : child;
+		};
+
+		if (NodeFactory::validNode(currNode.rightPos))
+			currNode.rightPos = adopt(currNode.rightPos);
+		if (NodeFactory::validNode(currNode.leftPos))
+			currNode.leftPos = adopt(currNode.leftPos);
+
+		results.emplace_back(simplify(currNodePos));
+		frames.pop_back();
+	}
+
+	return isIdentifierLeaf(results.back()) ? rootNodeExpression : results.back();
+}
+
+#endif // OPTIMIZER_IMPL_H
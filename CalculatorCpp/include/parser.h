@@ -6,6 +6,11 @@
 #include <unordered_set>
 #include <memory>
 #include <optional>
+#include <deque>
+#include <string_view>
+#include <stack>
+#include <span>
+#include <array>
 
 #include "result.h"
 #include "lexer.h"
@@ -23,10 +28,19 @@ struct ParserSyntaxError {
 inline const std::string ParserSyntaxError::prefix = "ParserSyntaxError";
 
 
+struct ParsedLexemes;
+
 class Parser {
 public:
 	using OperatorLevel = size_t;
 	using Lexeme = std::string;
+	using LexemeView = std::string_view;
+
+	// how createOperatorTree builds the trees, ShuntingYard is the OperatorTreeBuilder.
+	enum class OperatorTreeEngine : int8_t {
+		PrecedenceClimbing,
+		ShuntingYard,
+	};
 
 	enum class OperatorEvalType : int8_t {
 		Infix,
@@ -35,21 +49,171 @@ public:
 		Constant,
 	};
 
+	// everything the parser asks about a lexeme, looked up once when the lexeme comes in.
+	struct LexemeClass {
+		OperatorLevel Level{ 0 };
+		OperatorEvalType EvalType{ OperatorEvalType::Infix };
+		bool HasEvalType{ false };
+		bool HasLevel{ false };
+		bool IsOpenBracket{ false };
+		bool IsCloseBracket{ false };
+		bool IsNumber{ false }; // strictedIsNumber
+		bool IsOperand{ false }; // a number or a constant
+		uint32_t BracketId{ 0 }; // the same for both brackets of a pair, 0 when the lexeme is no bracket
+		bool IsRawExpressionBracket{ false }; // the pair holds a raw expression of RawExpressionType
+		NodeFactory::Node::NodeState RawExpressionType{ NodeFactory::Node::NodeState::Number };
+
+		bool is(OperatorEvalType operatorEvalType) const {
+			return HasEvalType && EvalType == operatorEvalType;
+		}
+	};
+
 private:
 	Brackets mBracketsOperators;
-	std::unordered_map<Lexeme, OperatorLevel> mOperatorLevels;
-	std::unordered_map<Lexeme, OperatorEvalType> mOperatorEvalTypes;
-	std::unordered_map<Lexeme, NodeFactory::Node::NodeState> mRawExpressionBracketEvalTypes;
+	StringMap<OperatorLevel> mOperatorLevels;
+	StringMap<OperatorEvalType> mOperatorEvalTypes;
+	StringMap<NodeFactory::Node::NodeState> mRawExpressionBracketEvalTypes;
+	StringMap<LexemeClass> mLexemeClasses; // the tables above merged, one entry per operator or bracket
+	std::array<std::optional<LexemeClass>, 256> mByteLexemeClasses; // the entries one byte long, looked up without hashing
+	StringMap<uint32_t> mBracketIds; // of every open bracket
+	OperatorTreeEngine mOperatorTreeEngine{ OperatorTreeEngine::PrecedenceClimbing };
+	size_t mParseThreads{ 1 };
+	bool mDigitLexemeClasses{ false }; // some entry starts with a digit, number lexemes have to be looked up too
 	bool mIsParserReady{ false };
 
 public:
-	static bool strictedIsNumber(const std::string& lexeme, bool veryStrict = false);
+	static bool strictedIsNumber(std::string_view lexeme, bool veryStrict = false);
 
 	// main functions
+	// tokens of Lexer::tokenize, the result points into content.
+	// rawStrings are the raw strings Lexer::tokenize listed, lambdas and storages are then built without lexing them again.
+	ParsedLexemes parseNumbers(std::string_view content, const std::vector<Token>& tokens, std::span<const RawStringSpan> rawStrings = {}) const;
+	Result<std::vector<NodeFactory::NodePos>> createOperatorTree(const std::vector<LexemeView>& parsedLexemes, const std::unordered_map<Parser::Lexeme, Lambda>& EvaluatorLambdaFunction) const;
+	Result<std::vector<NodeFactory::NodePos>> createOperatorTree(const ParsedLexemes& parsedLexemes, const std::unordered_map<Parser::Lexeme, Lambda>& EvaluatorLambdaFunction) const;
+	// nestedRawStrings are the raw strings inside RawExpression, when the lexer listed them already.
+	// enclosingParameters are the parameters of the lambdas RawExpression is written in, innermost first.
+	Result<NodeFactory::NodePos> createRawExpressionOperatorTree(std::string_view RawExpression, NodeFactory::Node::NodeState RawExpressionType, const std::unordered_map<Parser::Lexeme, Lambda>& EvaluatorLambdaFunction, std::span<const RawStringSpan> nestedRawStrings = {}, const KeywordOverlay* enclosingParameters = nullptr) const;
+
+	// string lexemes of Lexer::lexing, every lexeme is copied.
 	std::vector<Lexeme> parseNumbers(const std::vector<Lexeme>& lexemes) const;
 	Result<std::vector<NodeFactory::NodePos>> createOperatorTree(const std::vector<Lexeme>& parsedLexemes, const std::unordered_map<Parser::Lexeme, Lambda>& EvaluatorLambdaFunction) const;
-	Result<NodeFactory::NodePos> createRawExpressionOperatorTree(const std::string& RawExpression, NodeFactory::Node::NodeState RawExpressionType, const std::unordered_map<Parser::Lexeme, Lambda>& EvaluatorLambdaFunction) const;
 	NodeFactory::NodePos createRawExpressionStorage(const std::vector<NodeFactory::NodePos>& parsedExpressions) const;
+
+	// parseNumbers as a stage that is fed the lexemes a batch at a time, a number may continue into the next batch.
+	class NumberMerger {
+	public:
+		// parameters are constants next to the parser's operators, see createRawExpressionOperatorTree.
+		explicit NumberMerger(const Parser& parser, const KeywordOverlay* parameters = nullptr);
+
+		// lastBatch flushes the number being merged, nothing is left that could continue it.
+		// a number carried over from an earlier batch is copied, its text goes into result.Joined.
+		void feed(const std::vector<LexemeView>& lexemes, bool sharedContent, bool lastBatch, ParsedLexemes& result);
+
+	private:
+		void iEmit(LexemeView lexeme, ParsedLexemes& result);
+		void iOwnBuffer();
+
+		const Parser* mParser;
+		const KeywordOverlay* mParameters;
+		// the number being merged, a view of the lexemes while they lie next to each other, else of mNumberBuffer.
+		LexemeView mBuffered;
+		std::string mNumberBuffer;
+		bool mBufferOwned{ false };
+		bool mFoundDecimalPoint{ false };
+		bool mFoundMinusSign{ false };
+		bool mHasResult{ false };
+		bool mLastAllowsSign{ false }; // last result is an infix or postfix operator or an open bracket
+	};
+
+	// createOperatorTree as a stage that is pushed one lexeme at a time.
+	class OperatorTreeBuilder {
+	public:
+		// copyLexemes is for lexemes that don't outlive push, whatever stays on the operator stack is then copied
+		// (operators and brackets point at the parser's own keys instead).
+		// parameters are passed on to the lambdas and storages the lexemes hold.
+		OperatorTreeBuilder(const Parser& parser, const std::unordered_map<Parser::Lexeme, Lambda>& EvaluatorLambdaFunction, bool copyLexemes = false, const KeywordOverlay* parameters = nullptr);
+
+		// the content the lexemes point into and its raw strings, as listed by the lexer.
+		void setRawStrings(std::string_view content, std::span<const RawStringSpan> rawStrings);
+
+		// after the first error every push is ignored, finish returns it.
+		void push(LexemeView parsedLexeme, const LexemeClass& lexemeClass);
+		Result<std::vector<NodeFactory::NodePos>> finish();
+
+	private:
+		struct StackedOperator {
+			LexemeView Text;
+			LexemeClass Class;
+		};
+
+		std::optional<std::exception> iPush(LexemeView parsedLexeme, const LexemeClass& lexemeClass);
+		LexemeView iKeep(LexemeView lexeme);
+
+		const Parser* mParser;
+		const KeywordOverlay* mParameters;
+		const std::unordered_map<Parser::Lexeme, Lambda>* mEvaluatorLambdaFunction;
+		std::stack<NodeFactory::NodePos> mResultStack;
+		std::stack<StackedOperator> mOperatorStack;
+		std::unordered_map<NodeFactory::NodePos, RuntimeType> mSpecialTypes;
+		std::optional<std::exception> mError;
+		bool mReturnsEmpty{ false }; // a bracket closed over nothing, the whole tree is empty
+		bool mPreviousIsOperand{ false };
+		bool mCopyLexemes;
+		std::deque<std::string> mOwnedLexemes;
+		std::vector<size_t> mOwnedDepths; // operator stack position of every owned lexeme
+		std::string_view mContent;
+		std::span<const RawStringSpan> mRawStrings;
+		size_t mNextRawString{ 0 };
+	};
+
+	// createOperatorTree in one pass, every binary operator parses its right operand at the level above its own.
+	// It builds the trees the OperatorTreeBuilder builds, for the lexemes that read one way only: build gives up
+	// (std::nullopt) on the rest, like unknown lexemes the shunting-yard takes for operators or expressions written
+	// next to each other inside brackets, and those are left to the OperatorTreeBuilder.
+	class PrecedenceClimber {
+	public:
+		// parameters are passed on to the lambdas and storages the lexemes hold.
+		PrecedenceClimber(const Parser& parser, const ParsedLexemes& parsedLexemes, const std::unordered_map<Parser::Lexeme, Lambda>& EvaluatorLambdaFunction, const KeywordOverlay* parameters = nullptr);
+
+		// the nodes built before giving up are left to the caller to give back. A lambda applied while parsing stays
+		// applied then, which only happens for lexemes the shunting-yard reads oddly (a lambda written between it and its argument).
+		std::optional<Result<std::vector<NodeFactory::NodePos>>> build();
+		// build reads the lexemes [first, last) only, a piece of an expression split at its lowest operators.
+		// the lexemes before first are taken for the values of the expression built already.
+		void setRange(size_t first, size_t last);
+
+	private:
+		struct RawExpression {
+			NodeFactory::NodePos Node;
+			RuntimeType Type;
+		};
+
+		// std::nullopt stops the parse, mError tells an error from giving up.
+		std::optional<NodeFactory::NodePos> iExpression(OperatorLevel minLevel);
+		std::optional<NodeFactory::NodePos> iUnary();
+		std::optional<NodeFactory::NodePos> iPrimary();
+		std::optional<RawExpression> iRawExpression();
+		// the lexeme at mPosition starts an expression next to the one before, as the shunting-yard reads it.
+		bool iStartsNextExpression() const;
+		bool iClosesBracket(size_t position, uint32_t bracketId) const;
+
+		const Parser* mParser;
+		const ParsedLexemes* mParsedLexemes;
+		const KeywordOverlay* mParameters;
+		const std::unordered_map<Parser::Lexeme, Lambda>* mEvaluatorLambdaFunction;
+		std::unordered_map<NodeFactory::NodePos, RuntimeType> mSpecialTypes;
+		std::optional<std::exception> mError;
+		size_t mPosition{ 0 };
+		size_t mEnd;
+		bool mFollowsValue{ false };
+		size_t mNextRawString{ 0 };
+		size_t mPendingOperators{ 0 }; // binary operators waiting for their right operand
+		size_t mOpenBrackets{ 0 };
+		NodeFactory::NodePos mLastValue{ NodeFactory::NodePosNull }; // the top of the shunting-yard's result stack
+		NodeFactory::NodePos mCarried{ NodeFactory::NodePosNull }; // a raw expression that starts the next expression
+	};
+
+	class ExpressionStream; // defined below ParsedLexemes
 	
 	// setters
 	void setBracketOperators(const std::vector<std::pair<Lexeme, Lexeme>>& bracketPairs);
@@ -60,16 +224,69 @@ public:
 	void addOperatorEvalType(const Lexeme& operatorLexme, OperatorEvalType operatorEvalType);
 	void setRawExpressionBracketEvalType(const std::vector<std::pair<Lexeme, NodeFactory::Node::NodeState>>& rawExpressionBracketEvalTypePairs);
 	void addRawExpressionBracketEvalType(const Lexeme& openBracketLexeme, NodeFactory::Node::NodeState rawExpressionBracketEvalType);
+	// the ExpressionStream always uses the OperatorTreeBuilder, it is fed before the lexemes after it are known.
+	void setOperatorTreeEngine(OperatorTreeEngine operatorTreeEngine);
+	// createOperatorTree splits long expressions at their lowest operators and climbs the pieces on up to threadAmount
+	// threads, ParallelParseMinLexemes lexemes a thread at least. 1 (the default) parses on the calling thread only.
+	void setParseThreads(size_t threadAmount);
+	static constexpr size_t ParallelParseMinLexemes{ 1 << 15 };
 	
-	bool isOperator(const Lexeme& lexeme) const;
-	OperatorEvalType getOperatorType(const Lexeme& oprLexeme) const;
-	OperatorLevel getOperatorLevel(const Lexeme& oprLexeme) const;
+	bool isOperator(LexemeView lexeme) const;
+	OperatorEvalType getOperatorType(LexemeView oprLexeme) const;
+	OperatorLevel getOperatorLevel(LexemeView oprLexeme) const;
 	std::string printOpertatorTree(std::vector<NodeFactory::NodePos> trees, const std::unordered_map<Parser::Lexeme, Lambda>& EvaluatorLambdaFunctions) const;
 
 	std::optional<RuntimeError<ParserNotReadyError>> parserReady();
 	void _ignore_parserReady();
 private:
-	std::unordered_set<Lexeme> mTempConstant;
-	std::optional<std::runtime_error> getLambdaType(std::vector<std::pair<std::string, RuntimeType>>& parametersWithTypes, std::string parameterExpression) const;
-	bool checkIfValidParameterName(const std::string& parameter) const;
+	std::optional<std::runtime_error> getLambdaType(std::vector<std::pair<std::string, RuntimeType>>& parametersWithTypes, std::string parameterExpression, const KeywordOverlay* enclosingParameters) const;
+	bool checkIfValidParameterName(const std::string& parameter, const KeywordOverlay* enclosingParameters) const;
+	// a lambda's parameters are a layer on top of the tables above, which the lambda bodies share instead of copying.
+	// they are constants of ParameterLevel.
+	static constexpr OperatorLevel ParameterLevel{ 9 };
+	LexemeClass iLexemeClass(LexemeView lexeme, const KeywordOverlay* parameters = nullptr) const;
+	ParsedLexemes iParseNumbers(std::string_view content, const std::vector<Token>& tokens, std::span<const RawStringSpan> rawStrings, const KeywordOverlay* parameters) const;
+	Result<std::vector<NodeFactory::NodePos>> iCreateOperatorTree(const ParsedLexemes& parsedLexemes, const std::unordered_map<Parser::Lexeme, Lambda>& EvaluatorLambdaFunction, const KeywordOverlay* parameters) const;
+	// std::nullopt when the lexemes aren't split or a piece doesn't climb, iCreateOperatorTree reads them whole then.
+	std::optional<std::vector<NodeFactory::NodePos>> iCreateOperatorTreeParallel(const ParsedLexemes& parsedLexemes, const std::unordered_map<Parser::Lexeme, Lambda>& EvaluatorLambdaFunction) const;
+	// lambdaNode applied to argumentNode while parsing, the type of the result is kept with specialTypes.
+	static Result<NodeFactory::NodePos, std::runtime_error> iApplyLambda(std::unordered_map<NodeFactory::NodePos, RuntimeType>& specialTypes, NodeFactory::NodePos lambdaNode, NodeFactory::NodePos argumentNode, const std::unordered_map<Parser::Lexeme, Lambda>& EvaluatorLambdaFunction);
+	void iUpdateLexemeClass(const Lexeme& lexeme);
+	void iUpdateBracketClasses(const Lexeme& openBracket);
+};
+
+// the lexemes parseNumbers hands to createOperatorTree, views into the lexed content.
+// a number whose lexemes were written apart ("- 5") has no view of its own, its text is kept in Joined.
+struct ParsedLexemes {
+	std::vector<std::string_view> Lexemes;
+	std::vector<Parser::LexemeClass> Classes; // of every lexeme, as the parser sees it
+	std::deque<std::string> Joined;
+	std::string_view Content;
+	std::span<const RawStringSpan> RawStrings; // of Content, when the lexer listed them
+
+	void clear() {
+		Lexemes.clear();
+		Classes.clear();
+		Joined.clear();
+		Content = std::string_view();
+		RawStrings = std::span<const RawStringSpan>();
+	}
+};
+
+// both stages behind a TokenStream: tokens go in as they are lexed, the trees come out at finish.
+// nothing but the number being merged and the operator stack is kept between batches.
+class Parser::ExpressionStream {
+public:
+	ExpressionStream(const Parser& parser, const std::unordered_map<Parser::Lexeme, Lambda>& EvaluatorLambdaFunction);
+
+	void feed(const TokenStream& tokenStream, const std::vector<Token>& tokens);
+	Result<std::vector<NodeFactory::NodePos>> finish();
+
+private:
+	void iBuild(bool lastBatch);
+
+	NumberMerger mNumberMerger;
+	OperatorTreeBuilder mOperatorTreeBuilder;
+	std::vector<LexemeView> mLexemes;
+	ParsedLexemes mMerged;
 };
\ No newline at end of file
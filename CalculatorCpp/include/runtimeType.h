@@ -41,41 +41,38 @@ template <typename T>
 concept RuntimeTypeRequired = std::same_as<T, RuntimeCompoundType> || std::same_as<T, RuntimeBaseType>;
 
 // Class representing a compound type (storage or lambda)
+// Compound types are hash-consed: every distinct type is interned once for the whole program and a
+// RuntimeCompoundType only points at its entry, so copies don't allocate and equality is a pointer compare.
 class RuntimeCompoundType {
 private:
-    // Information about a lambda function
+    // Information about a lambda function (points into the interned type, valid for the program lifetime)
     struct LambdaInfo {
-        std::shared_ptr<RuntimeType> ReturnType;    // Pointer to the return type
-        std::shared_ptr<RuntimeType> ParamsType;    // Pointer to the parameter type
+        const RuntimeType* ReturnType;              // Pointer to the return type
+        const RuntimeType* ParamsType;              // Pointer to the parameter type
         size_t ParamsNumbers;                       // Number of parameters
     };
 
     // Information about a storage type (collection)
     struct StorageInfo {
-        std::shared_ptr<std::vector<RuntimeType>> Storage;  // Pointer to the vector of elements
-        size_t StorageSize;                                 // Size of the storage
+        const std::vector<RuntimeType>* Storage;    // Pointer to the vector of elements
+        size_t StorageSize;                         // Size of the storage
     };
 
-    // Hash for comparing RuntimeTypes
-    size_t mHashed;
+    // The single instance of one distinct compound type
+    struct Interned {
+        RuntimeBaseType Type;
+        std::vector<RuntimeType> Children;
+        size_t Hashed;
+    };
+
+    const Interned* mInterned;
 
 public:
     // Base type of the compound type (storage or lambda)
     RuntimeBaseType Type;
-    // Child types within the compound type (e.g., element types in storage)
-    std::vector<RuntimeType> Children;
-
-    // Copy constructor
-    RuntimeCompoundType(const RuntimeCompoundType& other);
 
-    // Move constructor (avoids unnecessary copying)
-    RuntimeCompoundType(RuntimeCompoundType&& other) noexcept;
-
-    // Copy assignment operator
-    RuntimeCompoundType& operator=(const RuntimeCompoundType& other);
-
-    // Move assignment operator
-    RuntimeCompoundType& operator=(RuntimeCompoundType&& other) noexcept;
+    // Child types within the compound type (e.g., element types in storage)
+    const std::vector<RuntimeType>& getChildren() const;
 
     // Static factory methods to create different compound types
     // * Storage - Creates a storage type from arguments (variadic template)
@@ -84,16 +81,13 @@ public:
     // * ParseString - Parses a string representation into a RuntimeType
 
     static RuntimeCompoundType gurantreeNoRuntimeEvaluateStorage(const std::vector<RuntimeType>& base);
-    static RuntimeCompoundType gurantreeNoRuntimeEvaluateStorage(std::vector<RuntimeType>&& base);
     template <RuntimeTypeRequired... Args>
     static RuntimeCompoundType Storage(Args&&... base);
     static RuntimeCompoundType Storage(const std::vector<RuntimeType>& base);
-    static RuntimeCompoundType Storage(std::vector<RuntimeType>&& base);
     static RuntimeCompoundType Lambda(const RuntimeType& Ret, const RuntimeType& Params);
-    static RuntimeCompoundType Lambda(RuntimeType&& Ret, RuntimeType&& Params);
     static Result<RuntimeType, std::runtime_error> ParseString(const std::string& stringLikeType);
 
-    // Funtion allow acessing mHashed
+    // Funtion allow acessing the structural hash
     size_t _getHash() const;
 
     // Function to extract information about a storage type from a RuntimeType object
@@ -121,29 +115,15 @@ public:
     friend class Storage;
 
 private:
-    size_t generateHash(RuntimeBaseType wrapper, const std::vector<RuntimeType>& base) const;
-    size_t generateHash(RuntimeBaseType wrapper, const RuntimeType& base) const;
+    static size_t generateHash(RuntimeBaseType wrapper, const std::vector<RuntimeType>& base);
+
+    // Returns the entry of the type, created on first use. Thread safe, each thread keeps a lock-free view of the entries it used.
+    static const Interned* intern(RuntimeBaseType wrapper, const std::vector<RuntimeType>& base);
 
     // Private constructor for compound types (used by factory methods)
     RuntimeCompoundType(RuntimeBaseType wrapper, const std::vector<RuntimeType>& base) :
-        mHashed{ generateHash(wrapper, base) },
-        Type{ wrapper },
-        Children{ base } {}
-
-    RuntimeCompoundType(RuntimeBaseType wrapper, std::vector<RuntimeType>&& base) :
-        mHashed{ generateHash(wrapper, base) },
-        Type{ wrapper },
-        Children{ std::move(base) } {}
-
-    RuntimeCompoundType(RuntimeBaseType wrapper, const RuntimeType& base) :
-        mHashed{ generateHash(wrapper, {base}) },
-        Type{ wrapper },
-        Children{ {base} } {}
-
-    RuntimeCompoundType(RuntimeBaseType wrapper, RuntimeType&& base) :
-        mHashed{ generateHash(wrapper, base) },
-        Type{ wrapper },
-        Children{ {std::move(base)} } {}
+        mInterned{ intern(wrapper, base) },
+        Type{ wrapper } {}
 };
 
 std::string RuntimeTypeToString(const RuntimeType& rt);
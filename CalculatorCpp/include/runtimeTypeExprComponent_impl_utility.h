@@ -129,7 +129,7 @@ inline NodeFactory::NodePos RuntimeTypedExprComponent::toNodeExpression() const
 		}, *this);
 }
 
-inline Result<RuntimeTypedExprComponent, std::runtime_error> RuntimeTypedExprComponent::fromNodeExpression(NodeFactory::NodePos rootNodeExpression, const std::unordered_map<std::string, Lambda>& EvaluatorLambdaFunctions) {
+inline Result<RuntimeTypedExprComponent, std::runtime_error> RuntimeTypedExprComponent::fromNodeExpression(NodeFactory::NodePos rootNodeExpression, const EvaluatorScope& EvaluatorLambdaFunctions) {
 	switch (NodeFactory::Node::NodeState currNodeState{ NodeFactory::node(rootNodeExpression).nodestate })
 	{
 	case NodeFactory::Node::NodeState::LambdaFuntion:
@@ -139,7 +139,7 @@ inline Result<RuntimeTypedExprComponent, std::runtime_error> RuntimeTypedExprCom
 			return RuntimeError<RuntimeTypeError>(
 				result.getException(),
 				std::format("When trying to convert nodeExpression (value=\"{}\") to LambdaFunction.",
-					NodeFactory::node(rootNodeExpression).value),
+					NodeFactory::node(rootNodeExpression).value()),
 				"RuntimeTypedExprComponent::fromNodeExpression"
 			);
 
@@ -153,7 +153,7 @@ inline Result<RuntimeTypedExprComponent, std::runtime_error> RuntimeTypedExprCom
 				result.getException(),
 				std::format(
 					"When trying to convert nodeExpression (value=\"{}\") to Operator.",
-					NodeFactory::node(rootNodeExpression).value
+					NodeFactory::node(rootNodeExpression).value()
 				),
 				"RuntimeTypedExprComponent::fromNodeExpression"
 			);
@@ -171,7 +171,7 @@ inline Result<RuntimeTypedExprComponent, std::runtime_error> RuntimeTypedExprCom
 				result.getException(),
 				std::format(
 					"When trying to convert nodeExpression (value=\"{}\") to Storage.",
-					NodeFactory::node(rootNodeExpression).value
+					NodeFactory::node(rootNodeExpression).value()
 				),
 				"RuntimeTypedExprComponent::fromNodeExpression"
 			);
@@ -224,86 +224,67 @@ inline bool _fastCheckRuntimeTypeArgumentsType(const RuntimeType& baseType, cons
 	return true;
 }
 
-inline Result<RuntimeType, std::runtime_error> getReturnType(NodeFactory::NodePos rootExpressionNode, const std::unordered_map<std::string, Lambda>& EvaluatorLambdaFunctions, bool useCache) {
-	static std::unordered_map<NodeFactory::NodePos, RuntimeType> nodeTypeCache;
-
+inline Result<RuntimeType, std::runtime_error> getReturnType(NodeFactory::NodePos rootExpressionNode, const EvaluatorScope& EvaluatorLambdaFunctions, bool useCache) {
 	if (!useCache) // reset cache
-		nodeTypeCache.clear();
+		NodeFactory::clearTypes();
+
+	// every node keeps its type in the NodeFactory, subtrees typed by an earlier call are not walked again.
+	auto typeOf = [](NodeFactory::NodePos nodePos) -> const RuntimeType* {
+		return NodeFactory::validNode(nodePos) ? NodeFactory::node(nodePos).type() : nullptr;
+	};
 
-	if (useCache && nodeTypeCache.contains(rootExpressionNode))
-		return nodeTypeCache[rootExpressionNode];
+	if (const RuntimeType* rootType{ typeOf(rootExpressionNode) })
+		return *rootType;
 
 	std::stack<NodeFactory::NodePos> operationStack;
-	std::unordered_map<NodeFactory::NodePos, RuntimeType> resultMap;
 
 	operationStack.push(rootExpressionNode);
 	while (!operationStack.empty()) {
 		const NodeFactory::NodePos currNodePos{ operationStack.top() };
 
-		if (!NodeFactory::validNode(currNodePos)) {
+		if (!NodeFactory::validNode(currNodePos) || typeOf(currNodePos)) {
 			operationStack.pop();
 			continue;
 		}
 
-		const NodeFactory::Node &currNode{ NodeFactory::node(currNodePos) }; // gurantree node to not change value, use reference.
+		NodeFactory::Node currNode{ NodeFactory::node(currNodePos) }; // only its type annotation is written.
 
 		// if currNode is a leaf node.
 		if (!NodeFactory::validNode(currNode.rightPos) &&
 			!NodeFactory::validNode(currNode.leftPos)) {
-			if (currNode.value == ".")
-				resultMap[currNodePos] = RuntimeBaseType::Number;
+			if (currNode.isNumber() || currNode.value() == ".")
+				currNode.setType(RuntimeBaseType::Number);
+
+			else if (const RuntimeType* parameterType{ currNode.isParameter() ? EvaluatorLambdaFunctions.parameterType(currNode.parameterSlot(), currNode.value()) : nullptr })
+				currNode.setType(*parameterType);
 
-			else if (EvaluatorLambdaFunctions.contains(currNode.value) &&
-				EvaluatorLambdaFunctions.at(currNode.value).getNotation() == Lambda::LambdaNotation::Constant) {
-				resultMap[currNodePos] = *EvaluatorLambdaFunctions.at(currNode.value).getLambdaInfo().ReturnType;
+			else if (EvaluatorLambdaFunctions.contains(currNode.value()) &&
+				EvaluatorLambdaFunctions.at(currNode.value()).getNotation() == Lambda::LambdaNotation::Constant) {
+				currNode.setType(*EvaluatorLambdaFunctions.at(currNode.value()).getLambdaInfo().ReturnType);
 			}
 
 			else if (currNode.nodestate == NodeFactory::Node::NodeState::Storage)
-				resultMap[currNodePos] = RuntimeBaseType::_Storage; // null storage
+				currNode.setType(RuntimeBaseType::_Storage); // null storage
 
 			else
-				resultMap[currNodePos] = RuntimeBaseType::Number;
+				currNode.setType(RuntimeBaseType::Number);
 		}
 
 		else if (currNode.nodestate == NodeFactory::Node::NodeState::LambdaFuntion) {
-			std::vector<std::pair<std::string, RuntimeType>> parameters{ currNode.utilityStorage };
+			std::vector<std::pair<std::string, RuntimeType>> parameters{ currNode.utilityStorage() };
 			std::vector<RuntimeType> returnTypes;
 			std::vector<RuntimeType> lambdaParameterType;
 			lambdaParameterType.reserve(parameters.size());
 
-			std::unordered_map<std::string, Lambda> tempEvaluatorLambdaFunctions(EvaluatorLambdaFunctions);
+			EvaluatorScope parameterScope{ EvaluatorScope::frame(EvaluatorLambdaFunctions, parameters) };
 
 			// depend on arguments size in this case the argument size should be either same as parameter or 0.
-			for (size_t ind{ 0 }; ind < parameters.size(); ind++) {
-				Result<Lambda, std::runtime_error> tempFunc{ Lambda::fromFunction(
-					parameters[ind].first,
-					RuntimeCompoundType::Lambda(
-						parameters[ind].second,
-						RuntimeBaseType::_Storage
-					),
-					Lambda::LambdaNotation::Constant,
-					[](const Lambda::LambdaArguments&) {
-						return NodeFactory::NodePosNull;
-					}
-				) };
-
-				if (tempFunc.isError())
-					return RuntimeError<LambdaConstructionError>(
-						tempFunc.getException(),
-						std::format(
-							"When attempting to create a constant lambda function \"{}\", which is used to assist in defining the return type",
-							parameters[ind].first
-						),
-						"getReturnType"
-					);
-
-				tempEvaluatorLambdaFunctions.try_emplace(parameters[ind].first, tempFunc.moveValue());
+			for (size_t ind{ 0 }; ind < parameters.size(); ind++)
 				lambdaParameterType.emplace_back(parameters[ind].second);
-			}
 
 			NodeFactory::NodePos currArgNodePos{ currNodePos };
 			while (NodeFactory::validNode(currArgNodePos)) {
-				Result<RuntimeType, std::runtime_error> result{ getReturnType(NodeFactory::node(currArgNodePos).leftPos, tempEvaluatorLambdaFunctions) };
+				Result<RuntimeType, std::runtime_error> result{ getReturnType(NodeFactory::node(currArgNodePos).leftPos, parameterScope) };
 
 				// Handle error occur from determining argument type
 				if (result.isError())
@@ -312,7 +293,7 @@ inline Result<RuntimeType, std::runtime_error> getReturnType(NodeFactory::NodePo
 						std::format(
 							"While determining argument type of \"{}\"",
 							NodeFactory::validNode(NodeFactory::node(currArgNodePos).leftPos)
-							? NodeFactory::node(currArgNodePos).leftNode().value
+							? NodeFactory::node(currArgNodePos).leftNode().value()
 							: "Null"
 						),
 						"getReturnType"
@@ -340,11 +321,11 @@ inline Result<RuntimeType, std::runtime_error> getReturnType(NodeFactory::NodePo
 			}
 
 			if (lambdaParameterType.empty())
-				resultMap[currNodePos] = RuntimeCompoundType::Lambda(std::move(returnTypes.back()), RuntimeBaseType::_Storage);
+				currNode.setType(RuntimeCompoundType::Lambda(std::move(returnTypes.back()), RuntimeBaseType::_Storage));
 			else if (lambdaParameterType.size() == 1)
-				resultMap[currNodePos] = RuntimeCompoundType::Lambda(std::move(returnTypes.back()), std::move(lambdaParameterType.front()));
+				currNode.setType(RuntimeCompoundType::Lambda(std::move(returnTypes.back()), std::move(lambdaParameterType.front())));
 			else
-				resultMap[currNodePos] = RuntimeCompoundType::Lambda(std::move(returnTypes.back()), RuntimeCompoundType::gurantreeNoRuntimeEvaluateStorage(std::move(lambdaParameterType)));
+				currNode.setType(RuntimeCompoundType::Lambda(std::move(returnTypes.back()), RuntimeCompoundType::gurantreeNoRuntimeEvaluateStorage(std::move(lambdaParameterType))));
 		}
 
 		else if (currNode.nodestate == NodeFactory::Node::NodeState::Storage) {
@@ -359,7 +340,7 @@ inline Result<RuntimeType, std::runtime_error> getReturnType(NodeFactory::NodePo
 						result.getException(),
 						std::format("While determining argument type of \"{}\"",
 							NodeFactory::validNode(NodeFactory::node(currArgNodePos).leftPos)
-							? NodeFactory::node(currArgNodePos).leftNode().value
+							? NodeFactory::node(currArgNodePos).leftNode().value()
 							: "Null"),
 						"getReturnType");
 
@@ -367,25 +348,25 @@ inline Result<RuntimeType, std::runtime_error> getReturnType(NodeFactory::NodePo
 				currArgNodePos = NodeFactory::node(currArgNodePos).rightPos;
 			}
 
-			resultMap[currNodePos] = RuntimeCompoundType::gurantreeNoRuntimeEvaluateStorage(arguments);
+			currNode.setType(RuntimeCompoundType::gurantreeNoRuntimeEvaluateStorage(arguments));
 		}
 
-		else if (EvaluatorLambdaFunctions.contains(currNode.value) && EvaluatorLambdaFunctions.at(currNode.value).getNotation() == Lambda::LambdaNotation::Infix) {
-			if (!resultMap.contains(currNode.leftPos)) {
+		else if (EvaluatorLambdaFunctions.contains(currNode.value()) && EvaluatorLambdaFunctions.at(currNode.value()).getNotation() == Lambda::LambdaNotation::Infix) {
+			if (!typeOf(currNode.leftPos)) {
 				operationStack.push(currNode.leftPos);
 				continue;
 			}
 
-			if (!resultMap.contains(currNode.rightPos)) {
+			if (!typeOf(currNode.rightPos)) {
 				operationStack.push(currNode.rightPos);
 				continue;
 			}
 
-			RuntimeType leftType{ resultMap[currNode.leftPos] };
-			RuntimeType rightType{ resultMap[currNode.rightPos] };
+			RuntimeType leftType{ *typeOf(currNode.leftPos) };
+			RuntimeType rightType{ *typeOf(currNode.rightPos) };
 
 			// Lambda parameter numbers is guarantree to be 2 (check at Lambda construction.)
-			const Lambda& lambdaFunction{ EvaluatorLambdaFunctions.at(currNode.value) };
+			const Lambda& lambdaFunction{ EvaluatorLambdaFunctions.at(currNode.value()) };
 			if (const auto& parametersType{ RuntimeCompoundType::getStorageInfo(*lambdaFunction.getLambdaInfo().ParamsType).Storage };
 				!((*parametersType)[0] == leftType && (*parametersType)[1] == rightType))
 
@@ -395,17 +376,17 @@ inline Result<RuntimeType, std::runtime_error> getReturnType(NodeFactory::NodePo
 						RuntimeType(RuntimeCompoundType::gurantreeNoRuntimeEvaluateStorage({ leftType, rightType }))),
 					"getReturnType");
 
-			resultMap[currNodePos] = *lambdaFunction.getLambdaInfo().ReturnType;
+			currNode.setType(*lambdaFunction.getLambdaInfo().ReturnType);
 		}
 
-		else if (EvaluatorLambdaFunctions.contains(currNode.value) && EvaluatorLambdaFunctions.at(currNode.value).getNotation() == Lambda::LambdaNotation::Postfix) {
-			if (!resultMap.contains(currNode.rightPos)) {
+		else if (EvaluatorLambdaFunctions.contains(currNode.value()) && EvaluatorLambdaFunctions.at(currNode.value()).getNotation() == Lambda::LambdaNotation::Postfix) {
+			if (!typeOf(currNode.rightPos)) {
 				operationStack.push(currNode.rightPos);
 				continue;
 			}
 
-			RuntimeType rightVal{ resultMap[currNode.rightPos] };
-			const Lambda& lambdaFunction{ EvaluatorLambdaFunctions.at(currNode.value) };
+			RuntimeType rightVal{ *typeOf(currNode.rightPos) };
+			const Lambda& lambdaFunction{ EvaluatorLambdaFunctions.at(currNode.value()) };
 			if (*lambdaFunction.getLambdaInfo().ParamsType != rightVal)
 				return RuntimeError<RuntimeTypeError>(
 					std::format("Parameters type must be equal to argument type. ({} != {})",
@@ -413,17 +394,17 @@ inline Result<RuntimeType, std::runtime_error> getReturnType(NodeFactory::NodePo
 						rightVal),
 					"getReturnType");
 
-			resultMap[currNodePos] = *lambdaFunction.getLambdaInfo().ReturnType;
+			currNode.setType(*lambdaFunction.getLambdaInfo().ReturnType);
 		}
 
-		else if (EvaluatorLambdaFunctions.contains(currNode.value) && EvaluatorLambdaFunctions.at(currNode.value).getNotation() == Lambda::LambdaNotation::Prefix) {
-			if (!resultMap.contains(currNode.leftPos)) {
+		else if (EvaluatorLambdaFunctions.contains(currNode.value()) && EvaluatorLambdaFunctions.at(currNode.value()).getNotation() == Lambda::LambdaNotation::Prefix) {
+			if (!typeOf(currNode.leftPos)) {
 				operationStack.push(currNode.leftPos);
 				continue;
 			}
 
-			RuntimeType leftVal{ resultMap[currNode.leftPos] };
-			const Lambda& lambdaFunction{ EvaluatorLambdaFunctions.at(currNode.value) };
+			RuntimeType leftVal{ *typeOf(currNode.leftPos) };
+			const Lambda& lambdaFunction{ EvaluatorLambdaFunctions.at(currNode.value()) };
 			if (*lambdaFunction.getLambdaInfo().ParamsType == leftVal)
 				return RuntimeError<RuntimeTypeError>(
 					std::format("Parameters type must be equal to argument type. ({} != {})",
@@ -431,22 +412,19 @@ inline Result<RuntimeType, std::runtime_error> getReturnType(NodeFactory::NodePo
 						leftVal),
 					"getReturnType");
 
-			resultMap[currNodePos] = *lambdaFunction.getLambdaInfo().ReturnType;
+			currNode.setType(*lambdaFunction.getLambdaInfo().ReturnType);
 		}
 
 		else {
-			std::cout << currNode.value << std::endl;
+			std::cout << currNode.value() << std::endl;
 		}
 
 		operationStack.pop();
 	}
 
-	if (!resultMap.contains(rootExpressionNode))
-		return std::runtime_error("failed to find return type.");
-
-	nodeTypeCache[rootExpressionNode] = resultMap[rootExpressionNode];
-
-	return resultMap[rootExpressionNode];
+	if (const RuntimeType* rootType{ typeOf(rootExpressionNode) })
+		return *rootType;
+	return std::runtime_error("failed to find return type.");
 }
 
 #endif //RUNTIME_TYPED_EXPR_COMPONENT_IMPL_UTILITY
\ No newline at end of file
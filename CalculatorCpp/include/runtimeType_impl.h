@@ -13,46 +13,52 @@
 #include <memory>
 #include <sstream>
 #include <cassert>
+#include <deque>
+#include <mutex>
+#include <algorithm>
+#include <unordered_map>
 
 #include "runtime_error.h"
 #include "runtimeType.h"
 #include "result.h"
 #include "lexer.h"
 
-// Copy constructor for RuntimeCompoundType
-inline RuntimeCompoundType::RuntimeCompoundType(const RuntimeCompoundType& other) :
-	mHashed{ other.mHashed },
-	Type{ other.Type },
-	Children{ other.Children } {
-	static size_t count{ 0 };
-	//std::cout << "copy: " << ++count << " " << *this << "\n";
+inline const std::vector<RuntimeType>& RuntimeCompoundType::getChildren() const {
+	return mInterned->Children;
 }
 
-// Move constructor for RuntimeCompoundType
-inline RuntimeCompoundType::RuntimeCompoundType(RuntimeCompoundType&& other) noexcept :
-	mHashed{ other.mHashed },
-	Type{ std::move(other.Type) },
-	Children{ std::move(other.Children) } {}
-
-// Copy assignment operator for RuntimeCompoundType
-inline RuntimeCompoundType& RuntimeCompoundType::operator=(const RuntimeCompoundType& other) {
-	if (this != &other) {
-		Type = other.Type;
-		Children = other.Children;
-		mHashed = other.mHashed;
-	}
+inline const RuntimeCompoundType::Interned* RuntimeCompoundType::intern(RuntimeBaseType wrapper, const std::vector<RuntimeType>& base) {
+	using Table = std::unordered_multimap<size_t, const Interned*>;
 
-	return *this;
-}
+	const size_t hashed{ generateHash(wrapper, base) };
+	auto find = [&](const Table& table) -> const Interned* {
+		for (auto [interned, end] { table.equal_range(hashed) }; interned != end; ++interned)
+			if (interned->second->Type == wrapper && std::ranges::equal(interned->second->Children, base, [](const RuntimeType& left, const RuntimeType& right) { return left == right; }))
+				return interned->second;
+		return nullptr;
+	};
 
-// Move assignment operator for RuntimeCompoundType
-inline RuntimeCompoundType& RuntimeCompoundType::operator=(RuntimeCompoundType&& other) noexcept {
-	if (this != &other) {
-		Type = std::move(other.Type);
-		Children = std::move(other.Children);
-		mHashed = other.mHashed;
+	thread_local Table threadTable;
+	if (const Interned* interned{ find(threadTable) })
+		return interned;
+
+	// never destroyed, types can still be compared while static objects are torn down.
+	static std::mutex* sharedMutex{ new std::mutex };
+	static Table* sharedTable{ new Table };
+	static std::deque<Interned>* entries{ new std::deque<Interned> };
+
+	const Interned* interned;
+	{
+		std::scoped_lock lock{ *sharedMutex };
+		interned = find(*sharedTable);
+		if (!interned) {
+			interned = &entries->emplace_back(Interned{ wrapper, base, hashed });
+			sharedTable->emplace(hashed, interned);
+		}
 	}
-	return *this;
+
+	threadTable.emplace(hashed, interned);
+	return interned;
 }
 
 // Create a RuntimeCompoundType with a vector of RuntimeType elements
@@ -60,11 +66,6 @@ inline RuntimeCompoundType RuntimeCompoundType::gurantreeNoRuntimeEvaluateStorag
 	return RuntimeCompoundType(RuntimeBaseType::_Storage, base);
 }
 
-// Create a RuntimeCompoundType with a rvalue vector of RuntimeType elements
-inline RuntimeCompoundType RuntimeCompoundType::gurantreeNoRuntimeEvaluateStorage(std::vector<RuntimeType>&& base) {
-	return RuntimeCompoundType(RuntimeBaseType::_Storage, std::move(base));
-}
-
 // Create a RuntimeCompoundType with variadic arguments of RuntimeType elements
 template <RuntimeTypeRequired... Args>
 inline RuntimeCompoundType RuntimeCompoundType::Storage(Args&&... base) {
@@ -72,7 +73,7 @@ inline RuntimeCompoundType RuntimeCompoundType::Storage(Args&&... base) {
 	std::vector<RuntimeType> tmp;
 	tmp.reserve(count);
 	(tmp.emplace_back(std::move(std::forward<Args>(base))), ...);
-	return RuntimeCompoundType(RuntimeBaseType::_Storage, std::move(tmp));
+	return RuntimeCompoundType(RuntimeBaseType::_Storage, tmp);
 }
 
 // Create a RuntimeCompoundType with a vector of RuntimeType elements
@@ -81,30 +82,16 @@ inline RuntimeCompoundType RuntimeCompoundType::Storage(const std::vector<Runtim
 	return RuntimeCompoundType(RuntimeBaseType::_Storage, base);
 }
 
-// Create a RuntimeCompoundType with a rvalue vector of RuntimeType elements
-inline RuntimeCompoundType RuntimeCompoundType::Storage(std::vector<RuntimeType>&& base) {
-	for (const RuntimeType& element : base) assert(std::holds_alternative<RuntimeEvaluate>(element));
-	return RuntimeCompoundType(RuntimeBaseType::_Storage, std::move(base));
-}
-
 // Create a RuntimeCompoundType representing a lambda with return type and parameters
 inline RuntimeCompoundType RuntimeCompoundType::Lambda(const RuntimeType& Ret, const RuntimeType& Params) {
 	return RuntimeCompoundType(RuntimeBaseType::_Lambda, { Ret, Params });
 }
 
-// Create a RuntimeCompoundType representing a lambda with return type and parameters
-inline RuntimeCompoundType RuntimeCompoundType::Lambda(RuntimeType&& Ret, RuntimeType&& Params) {
-	std::vector<RuntimeType> tmp;
-	tmp.reserve(2);
-	tmp.emplace_back(std::move(Ret));
-	tmp.emplace_back(std::move(Params));
-	return RuntimeCompoundType(RuntimeBaseType::_Lambda, std::move(tmp));
-}
 // Parse a string representing a RuntimeType
 inline Result<RuntimeType, std::runtime_error> RuntimeCompoundType::ParseString(const std::string& stringLikeType) {
 	// Initialize the lexer if not already done
-	static Lexer lex;
-	static bool initialized = false;
+	thread_local Lexer lex;
+	thread_local bool initialized = false;
 
 	if (!initialized)
 		lex.setKeywords({ "Number", "NodePointer",  "Storage", "Lambda", "[", "]" });
@@ -177,8 +164,8 @@ inline RuntimeCompoundType::StorageInfo RuntimeCompoundType::getStorageInfo(cons
 	const RuntimeCompoundType& storageCompound = std::get<RuntimeCompoundType>(storage);
 
 	return StorageInfo{
-		std::make_shared<std::vector<RuntimeType>>(storageCompound.Children),
-		storageCompound.Children.size()
+		&storageCompound.getChildren(),
+		storageCompound.getChildren().size()
 	};
 }
 
@@ -186,25 +173,25 @@ inline RuntimeCompoundType::StorageInfo RuntimeCompoundType::getStorageInfo(cons
 inline RuntimeCompoundType::LambdaInfo RuntimeCompoundType::getLambdaInfo(const RuntimeType& lambda) {
 	assert(std::get_if<RuntimeCompoundType>(&lambda)->Type == RuntimeBaseType::_Lambda);
 
-	const RuntimeCompoundType& lambdaCompound = std::get<RuntimeCompoundType>(lambda);
+	const std::vector<RuntimeType>& lambdaChildren = std::get<RuntimeCompoundType>(lambda).getChildren();
 
-	if (std::holds_alternative<RuntimeCompoundType>(lambdaCompound.Children[1]))
+	if (std::holds_alternative<RuntimeCompoundType>(lambdaChildren[1]))
 		return LambdaInfo{
-			std::make_shared<RuntimeType>(lambdaCompound.Children[0]),
-			std::make_shared<RuntimeType>(lambdaCompound.Children[1]),
-			getStorageInfo(lambdaCompound.Children[1]).StorageSize
+			&lambdaChildren[0],
+			&lambdaChildren[1],
+			getStorageInfo(lambdaChildren[1]).StorageSize
 	};
 
-	if (std::get<RuntimeBaseType>(lambdaCompound.Children[1]) == RuntimeBaseType::_Storage)
+	if (std::get<RuntimeBaseType>(lambdaChildren[1]) == RuntimeBaseType::_Storage)
 		return LambdaInfo{
-			std::make_shared<RuntimeType>(lambdaCompound.Children[0]),
-			std::make_shared<RuntimeType>(lambdaCompound.Children[1]),
+			&lambdaChildren[0],
+			&lambdaChildren[1],
 			0
 	};
 
 	return LambdaInfo{
-		std::make_shared<RuntimeType>(lambdaCompound.Children[0]),
-		std::make_shared<RuntimeType>(lambdaCompound.Children[1]),
+		&lambdaChildren[0],
+		&lambdaChildren[1],
 		1
 	};
 }
@@ -213,39 +200,48 @@ inline RuntimeType RuntimeCompoundType::_getLambdaParamsType(const RuntimeType&
 	assert(std::get_if<RuntimeCompoundType>(&lambda)->Type == RuntimeBaseType::_Lambda);
 
 	const RuntimeCompoundType& lambdaCompound = std::get<RuntimeCompoundType>(lambda);
-	return lambdaCompound.Children[1];
+	return lambdaCompound.getChildren()[1];
 }
 
 inline RuntimeType RuntimeCompoundType::_getLambdaReturnType(const RuntimeType& lambda) {
 	assert(std::get_if<RuntimeCompoundType>(&lambda)->Type == RuntimeBaseType::_Lambda);
 
 	const RuntimeCompoundType& lambdaCompound = std::get<RuntimeCompoundType>(lambda);
-	return lambdaCompound.Children[0];
+	return lambdaCompound.getChildren()[0];
 }
 
 inline size_t RuntimeCompoundType::_getLambdaParamsNumbers(const RuntimeType& lambda) {
 	assert(std::get_if<RuntimeCompoundType>(&lambda)->Type == RuntimeBaseType::_Lambda);
 
-	const RuntimeCompoundType& lambdaCompound = std::get<RuntimeCompoundType>(lambda);
+	const std::vector<RuntimeType>& lambdaChildren = std::get<RuntimeCompoundType>(lambda).getChildren();
 
-	if (std::holds_alternative<RuntimeCompoundType>(lambdaCompound.Children[1])) {
-		assert(std::get_if<RuntimeCompoundType>(&lambdaCompound.Children[1])->Type == RuntimeBaseType::_Storage);
-		return std::get<RuntimeCompoundType>(lambdaCompound.Children[1]).Children.size();
+	if (std::holds_alternative<RuntimeCompoundType>(lambdaChildren[1])) {
+		assert(std::get_if<RuntimeCompoundType>(&lambdaChildren[1])->Type == RuntimeBaseType::_Storage);
+		return std::get<RuntimeCompoundType>(lambdaChildren[1]).getChildren().size();
 	}
 
-	if (std::get<RuntimeBaseType>(lambdaCompound.Children[1]) == RuntimeBaseType::_Storage)
+	if (std::get<RuntimeBaseType>(lambdaChildren[1]) == RuntimeBaseType::_Storage)
 		return 0;
 
 	return 1;
 }
 
 inline size_t RuntimeCompoundType::_getHash() const {
-	return mHashed;
+	return mInterned->Hashed;
 }
 
-// Equality operator for RuntimeType, use hash to compare types.
+// Equality operator for RuntimeType, equal compound types share their interned entry.
 inline bool operator==(const RuntimeType& runtimeType1, const RuntimeType& runtimeType2) {
-	return std::hash<RuntimeType>{}(runtimeType1) == std::hash<RuntimeType>{}(runtimeType2);
+	if (runtimeType1.index() != runtimeType2.index())
+		return false;
+
+	if (const RuntimeCompoundType* runtimeCompoundType{ std::get_if<RuntimeCompoundType>(&runtimeType1) }; runtimeCompoundType)
+		return runtimeCompoundType->mInterned == std::get<RuntimeCompoundType>(runtimeType2).mInterned;
+
+	if (const RuntimeBaseType* runtimeBaseType{ std::get_if<RuntimeBaseType>(&runtimeType1) }; runtimeBaseType)
+		return *runtimeBaseType == std::get<RuntimeBaseType>(runtimeType2);
+
+	return true; // both RuntimeEvaluate
 }
 
 // Output operator for RuntimeBaseType
@@ -281,7 +277,7 @@ inline std::ostream& operator<<(std::ostream& os, const RuntimeType& et) {
 		}
 
 		os << "(";
-		for (const auto& child : runtimeCompoundType->Children)
+		for (const auto& child : runtimeCompoundType->getChildren())
 			os << child << ", ";
 		os << "\b\b)";
 	}
@@ -310,7 +306,7 @@ inline std::string RuntimeTypeToString(const RuntimeType& rt) {
 		}
 
 		oss << "(";
-		for (const auto& child : runtimeCompoundType->Children)
+		for (const auto& child : runtimeCompoundType->getChildren())
 			oss << child << ", ";
 		oss << "\b\b)";
 	}
@@ -335,14 +331,14 @@ inline std::ostream& operator<<(std::ostream& os, const RuntimeCompoundType& ect
 	}
 
 	os << "(";
-	for (const auto& child : ect.Children)
+	for (const auto& child : ect.getChildren())
 		os << child << ", ";
 	os << "\b\b)";
 
 	return os;
 }
 
-inline size_t RuntimeCompoundType::generateHash(RuntimeBaseType wrapper, const std::vector<RuntimeType>& base) const {
+inline size_t RuntimeCompoundType::generateHash(RuntimeBaseType wrapper, const std::vector<RuntimeType>& base) {
 	size_t seed = 0;
 
 	// Hash the base type
@@ -351,7 +347,7 @@ inline size_t RuntimeCompoundType::generateHash(RuntimeBaseType wrapper, const s
 	// Hash the children
 	for (const auto& child : base) {
 		if (std::holds_alternative<RuntimeCompoundType>(child))
-			hash_combine(seed, std::get<RuntimeCompoundType>(child).mHashed);
+			hash_combine(seed, std::get<RuntimeCompoundType>(child)._getHash());
 		else if (std::holds_alternative<RuntimeBaseType>(child))
 			hash_combine(seed, std::hash<char>{}(static_cast<char>(std::get<RuntimeBaseType>(child))));
 		else
@@ -360,23 +356,6 @@ inline size_t RuntimeCompoundType::generateHash(RuntimeBaseType wrapper, const s
 	return seed;
 }
 
-inline size_t RuntimeCompoundType::generateHash(RuntimeBaseType wrapper, const RuntimeType& base) const {
-	size_t seed = 0;
-
-	// Hash the base type
-	hash_combine(seed, wrapper);
-
-	// Hash the children
-	if (std::holds_alternative<RuntimeCompoundType>(base))
-		hash_combine(seed, std::get<RuntimeCompoundType>(base).mHashed);
-	else if (std::holds_alternative<RuntimeBaseType>(base))
-		hash_combine(seed, std::hash<char>{}(static_cast<char>(std::get<RuntimeBaseType>(base))));
-	else
-		hash_combine(seed, std::hash<char>{}(static_cast<char>(std::get<RuntimeEvaluate>(base))));
-
-	return seed;
-}
-
 template <typename T>
 inline void hash_combine(size_t& seed, const T& v) {
 	seed ^= std::hash<T>{}(v)+0x9e3779b9 + (seed << 6) + (seed >> 2);
@@ -385,6 +364,8 @@ inline void hash_combine(size_t& seed, const T& v) {
 inline std::size_t std::hash<RuntimeType>::operator()(const RuntimeType& rt) const {
 	if (std::holds_alternative<RuntimeBaseType>(rt))
 		return std::hash<char>{}(static_cast<char>(std::get<RuntimeBaseType>(rt)));
+	if (std::holds_alternative<RuntimeEvaluate>(rt))
+		return std::hash<char>{}(static_cast<char>(std::get<RuntimeEvaluate>(rt)));
 	return std::get<RuntimeCompoundType>(rt)._getHash();
 }
 
@@ -3,10 +3,15 @@
 #include <string>
 #include <optional>
 #include <functional>
+#include <span>
+#include <vector>
 
 #include "runtimeType.h"
 #include "nodeFactory.h"
 #include "result.h"
+#include "evaluatorScope.h"
+#include "bytecode.h"
+#include "optimizer.h"
 
 class Storage;
 class Lambda;
@@ -79,7 +84,7 @@ protected:
 
 std::vector<std::string_view> splitString(std::string_view in, char sep);
 bool _fastCheckRuntimeTypeArgumentsType(const RuntimeType& baseType, const std::vector<RuntimeTypedExprComponent>& argumentsCheckType);
-Result<RuntimeType, std::runtime_error> getReturnType(NodeFactory::NodePos rootExpressionNode, const std::unordered_map<std::string, Lambda>& EvaluatorLambdaFunctions, bool useCache = true);
+Result<RuntimeType, std::runtime_error> getReturnType(NodeFactory::NodePos rootExpressionNode, const EvaluatorScope& EvaluatorLambdaFunctions, bool useCache = true);
 
 class Number : public BaseRuntimeTypedExprComponent {
 public:
@@ -108,22 +113,38 @@ public:
 		Constant
 	};
 
+	// built-in numeric operations the bytecode compiler may run without calling the lambda.
+	enum class Intrinsic : uint8_t {
+		None,
+		Add,
+		Subtract,
+		Multiply,
+		Divide,
+		Power,
+		And,
+		Or,
+		SquareRoot
+	};
+
 	Lambda(const Lambda& other);
 	Lambda& operator=(const Lambda& other);
 	Lambda(Lambda&& other) noexcept;
 	Lambda& operator=(Lambda&& other) noexcept;
 
-	static Result<Lambda, std::runtime_error> fromFunction(const std::string& lambdaFunctionSignature, const RuntimeCompoundType& lambdaType, LambdaNotation lambdaNotation, const std::function<RuntimeTypedExprComponent(LambdaArguments)>& lambdaFunction);
+	static Result<Lambda, std::runtime_error> fromFunction(const std::string& lambdaFunctionSignature, const RuntimeCompoundType& lambdaType, LambdaNotation lambdaNotation, const std::function<RuntimeTypedExprComponent(LambdaArguments)>& lambdaFunction, Intrinsic intrinsic = Intrinsic::None);
 	static Result<Lambda, std::runtime_error> fromFunction(const std::string& lambdaFunctionSignature, const RuntimeCompoundType& lambdaType, LambdaNotation lambdaNotation, const std::function<RuntimeTypedExprComponent(LambdaArguments)>& lambdaFunction, const LambdaArguments& testArgument);
-	static Result<Lambda, std::runtime_error> fromExpressionNode(NodePos lambdaFunctionRootNode, const std::unordered_map<std::string, Lambda>& EvaluatorLambdaFunctions);
+	static Result<Lambda, std::runtime_error> fromExpressionNode(NodePos lambdaFunctionRootNode, const EvaluatorScope& EvaluatorLambdaFunctions);
 
 	template<RuntimeTypedExprComponentRequired ...Args>
-	Result<RuntimeTypedExprComponent, std::runtime_error> evaluate(const std::unordered_map<std::string, Lambda>& EvaluatorLambdaFunctions, Args&&... arguments) const;
-	Result<RuntimeTypedExprComponent, std::runtime_error> evaluate(const std::unordered_map<std::string, Lambda>& EvaluatorLambdaFunctions, const LambdaArguments& arguments) const;
+	Result<RuntimeTypedExprComponent, std::runtime_error> evaluate(const EvaluatorScope& EvaluatorLambdaFunctions, Args&&... arguments) const;
+	Result<RuntimeTypedExprComponent, std::runtime_error> evaluate(const EvaluatorScope& EvaluatorLambdaFunctions, const LambdaArguments& arguments) const;
+	// the lambda evaluated at every argument at once, std::nullopt unless Bytecode::compileBatch takes it (evaluate it one argument at a time then).
+	std::optional<std::vector<long double>> evaluateBatch(const EvaluatorScope& EvaluatorLambdaFunctions, std::span<const long double> arguments) const;
 	Result<NodePos, std::runtime_error> getExpressionTree(const LambdaArguments& arguments) const;
 	RuntimeCompoundType::LambdaInfo getLambdaInfo() const;
 	std::optional<std::string_view> getLambdaSignature() const;
 	LambdaNotation getNotation() const;
+	Intrinsic getIntrinsic() const;
 	std::string toString() const override;
 	NodePos generateExpressionTree(const std::string& functionSignature) const;
 	NodePos generateExpressionTree() const override;
@@ -134,11 +155,19 @@ private:
 
 	std::variant<std::shared_ptr<std::function<RuntimeTypedExprComponent(LambdaArguments)>>, NodePos> mLambdaFunction;
 	std::optional<std::string> mLambdaFunctionSignature;
+	Intrinsic mIntrinsic{ Intrinsic::None };
 
-	Lambda(const std::string& lambdaFunctionSignature, const RuntimeCompoundType& lambdaType, LambdaNotation lambdaNotation, const std::function<RuntimeTypedExprComponent(LambdaArguments)>& lambdaFunction);
+	Lambda(const std::string& lambdaFunctionSignature, const RuntimeCompoundType& lambdaType, LambdaNotation lambdaNotation, const std::function<RuntimeTypedExprComponent(LambdaArguments)>& lambdaFunction, Intrinsic intrinsic = Intrinsic::None);
 	Lambda(const RuntimeCompoundType& lambdaType, LambdaNotation lambdaNotation, NodePos lambdaFunctionRootNode);
-	static Result<RuntimeTypedExprComponent, std::runtime_error> _NodeExpressionEvaluate(NodePos rootNodeExpression, const std::unordered_map<std::string, Lambda>& EvaluatorLambdaFunctions);
-	static Result<std::vector<RuntimeTypedExprComponent>, std::runtime_error> _NodeExpressionsEvaluator(std::vector<NodePos> rootNodeExpressions, const std::unordered_map<std::string, Lambda>& EvaluatorLambdaFunctions);
+	static Result<RuntimeTypedExprComponent, std::runtime_error> _NodeExpressionEvaluate(NodePos rootNodeExpression, const EvaluatorScope& EvaluatorLambdaFunctions);
+	static Result<RuntimeTypedExprComponent, std::runtime_error> _NodeBodyEvaluate(NodePos lambdaNode, const EvaluatorScope& EvaluatorLambdaFunctions);
+	static Result<RuntimeTypedExprComponent, std::runtime_error> _NodeExpressionTreeWalk(NodePos rootNodeExpression, const EvaluatorScope& EvaluatorLambdaFunctions);
+	static Result<RuntimeTypedExprComponent, std::runtime_error> _applyInfix(const Lambda& lambdaFunction, RuntimeTypedExprComponent& leftVal, RuntimeTypedExprComponent& rightVal, const EvaluatorScope& EvaluatorLambdaFunctions);
+	static Result<RuntimeTypedExprComponent, std::runtime_error> _applyPostfix(const Lambda& lambdaFunction, RuntimeTypedExprComponent& rightVal, const EvaluatorScope& EvaluatorLambdaFunctions);
+	static Result<RuntimeTypedExprComponent, std::runtime_error> _applyPrefix(const Lambda& lambdaFunction, RuntimeTypedExprComponent& leftVal, const EvaluatorScope& EvaluatorLambdaFunctions);
+
+	friend class Bytecode;
+	static Result<std::vector<RuntimeTypedExprComponent>, std::runtime_error> _NodeExpressionsEvaluator(std::vector<NodePos> rootNodeExpressions, const EvaluatorScope& EvaluatorLambdaFunctions);
 
 	friend class Storage;
 	friend class Evaluate;
@@ -160,7 +189,7 @@ public:
 	template <RuntimeTypedExprComponentRequired ...Args>
 	static Storage fromArgs(Args &&...storageData);
 	static Result<Storage, std::runtime_error> fromVector(const RuntimeCompoundType& storageType, const StorageArguments& storageData);
-	static Result<Storage, std::runtime_error> fromExpressionNode(NodePos storageRootNode, const std::unordered_map<std::string, Lambda>& EvaluatorLambdaFunctions);
+	static Result<Storage, std::runtime_error> fromExpressionNode(NodePos storageRootNode, const EvaluatorScope& EvaluatorLambdaFunctions);
 	const RuntimeTypedExprComponent& operator[](size_t index) const;
 	const std::vector<RuntimeTypedExprComponent>& getData() const;
 	size_t size() const;
@@ -173,6 +202,8 @@ private:
 
 	Storage(const RuntimeCompoundType& storageType, const StorageArguments& storageData);
 	Storage(RuntimeCompoundType&& storageType, StorageArguments&& storageData);
+
+	static RuntimeCompoundType iStorageTypeOf(const StorageArguments& storageData);
 };
 
 // act like a void pointer
@@ -183,11 +214,11 @@ public:
 	explicit NodePointer();
 
 	// getter
-	bool isTypeValid(const std::unordered_map<std::string, Lambda>& EvaluatorLambdaFunction) const;
+	bool isTypeValid(const EvaluatorScope& EvaluatorLambdaFunction) const;
 	bool isNodePointerValid() const;
-	Result<RuntimeTypedExprComponent, std::runtime_error> getPointed(const std::unordered_map<std::string, Lambda>& EvaluatorLambdaFunction) const;
+	Result<RuntimeTypedExprComponent, std::runtime_error> getPointed(const EvaluatorScope& EvaluatorLambdaFunction) const;
 	NodePos getPointerIndex() const;
-	const NodeFactory::Node& getPointerNode() const;
+	NodeFactory::Node getPointerNode() const;
 
 	// setter
 	void changePoint(NodePos target);
@@ -214,7 +245,7 @@ public:
 	RuntimeTypedExprComponent(RuntimeTypedExprComponent&& component) noexcept;
 
 	// static constructor
-	static Result<RuntimeTypedExprComponent, std::runtime_error> fromNodeExpression(NodeFactory::NodePos rootNodeExpression, const std::unordered_map<std::string, Lambda>& EvaluatorLambdaFunctions);
+	static Result<RuntimeTypedExprComponent, std::runtime_error> fromNodeExpression(NodeFactory::NodePos rootNodeExpression, const EvaluatorScope& EvaluatorLambdaFunctions);
 	
 	// getters
 	const Number& getNumber() const;
@@ -256,4 +287,7 @@ struct std::formatter<RuntimeTypedExprComponent> : std::formatter<std::string> {
 #include "runtimeTypedExprComponent_impl_number.h"
 #include "runtimeTypedExprComponent_impl_storage.h"
 #include "runtimeTypedExprComponent_impl_nodePointer.h"
-#include "runtimeTypeExprComponent_impl_utility.h"
\ No newline at end of file
+#include "runtimeTypeExprComponent_impl_utility.h"
+#include "evaluatorScope_impl.h"
+#include "bytecode_impl.h"
+#include "optimizer_impl.h"
\ No newline at end of file
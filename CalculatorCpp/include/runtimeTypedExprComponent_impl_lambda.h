@@ -8,13 +8,15 @@
 #include <variant>
 #include "runtimeTypedExprComponent.h"
 #include "runtime_error.h"
+#include "numberText.h"
 
 inline Lambda::Lambda(const Lambda& other) :
 	BaseRuntimeTypedExprComponent(other.getType(), other._getNodeExpression()),
 	mLambdaInfo{ other.mLambdaInfo },
 	mLambdaNotation{ other.mLambdaNotation },
 	mLambdaFunction{ other.mLambdaFunction },
-	mLambdaFunctionSignature{ other.mLambdaFunctionSignature } {}
+	mLambdaFunctionSignature{ other.mLambdaFunctionSignature },
+	mIntrinsic{ other.mIntrinsic } {}
 
 inline Lambda& Lambda::operator=(const Lambda& other) {
 	if (this != &other) {
@@ -24,6 +26,7 @@ inline Lambda& Lambda::operator=(const Lambda& other) {
 		mLambdaInfo = other.mLambdaInfo;
 		mLambdaFunction = other.mLambdaFunction;
 		mLambdaFunctionSignature = other.mLambdaFunctionSignature;
+		mIntrinsic = other.mIntrinsic;
 	}
 	return *this;
 }
@@ -36,7 +39,8 @@ inline Lambda::Lambda(Lambda&& other) noexcept :
 	mLambdaInfo(std::move(other.mLambdaInfo)),
 	mLambdaNotation(other.mLambdaNotation),
 	mLambdaFunction(std::move(other.mLambdaFunction)),
-	mLambdaFunctionSignature(std::move(other.mLambdaFunctionSignature)) {}
+	mLambdaFunctionSignature(std::move(other.mLambdaFunctionSignature)),
+	mIntrinsic(other.mIntrinsic) {}
 
 inline Lambda& Lambda::operator=(Lambda&& other) noexcept {
 	if (this != &other) {
@@ -46,6 +50,7 @@ inline Lambda& Lambda::operator=(Lambda&& other) noexcept {
 		mLambdaNotation = other.mLambdaNotation;
 		mLambdaFunction = std::move(other.mLambdaFunction);
 		mLambdaFunctionSignature = std::move(other.mLambdaFunctionSignature);
+		mIntrinsic = other.mIntrinsic;
 	}
 	return *this;
 }
@@ -54,12 +59,14 @@ inline Lambda::Lambda(
 	const std::string& lambdaFunctionSignature,
 	const RuntimeCompoundType& lambdaType,
 	LambdaNotation lambdaNotation,
-	const std::function<RuntimeTypedExprComponent(LambdaArguments)>& lambdaFunction) :
+	const std::function<RuntimeTypedExprComponent(LambdaArguments)>& lambdaFunction,
+	Intrinsic intrinsic) :
 	BaseRuntimeTypedExprComponent(lambdaType, NodeFactory::NodePosNull),
 	mLambdaInfo{ RuntimeCompoundType::getLambdaInfo(lambdaType) },
 	mLambdaNotation{ lambdaNotation },
 	mLambdaFunction{ std::make_shared<std::function<RuntimeTypedExprComponent(LambdaArguments)>>(lambdaFunction) },
-	mLambdaFunctionSignature{ lambdaFunctionSignature }
+	mLambdaFunctionSignature{ lambdaFunctionSignature },
+	mIntrinsic{ intrinsic }
 {
 	// gurantree noexcept, assertion will be test in wrapper function
 	// assert(mmLambdaInfo.ParamsNumbers == mLambdaParametersName.size());
@@ -85,15 +92,22 @@ inline Result<Lambda, std::runtime_error> Lambda::fromFunction(
 	const std::string& lambdaFunctionSignature,
 	const RuntimeCompoundType& lambdaType,
 	LambdaNotation lambdaNotation,
-	const std::function<RuntimeTypedExprComponent(LambdaArguments)>& lambdaFunction)
+	const std::function<RuntimeTypedExprComponent(LambdaArguments)>& lambdaFunction,
+	Intrinsic intrinsic)
 {
 	// Lambda return type will be check at runtime.
 	if (lambdaNotation == LambdaNotation::Infix &&
 		(lambdaType.Type != RuntimeBaseType::_Lambda ||
-			std::get_if<RuntimeCompoundType>(&lambdaType.Children[1])->Type != RuntimeBaseType::_Storage ||
+			std::get_if<RuntimeCompoundType>(&lambdaType.getChildren()[1])->Type != RuntimeBaseType::_Storage ||
 			RuntimeCompoundType::_getLambdaParamsNumbers(lambdaType) != 2))
 		return RuntimeError<RuntimeTypeError>(std::format("Lambda Infix LambdaNotation must be a Storage with 2 argument. (cannot be \"{}\")", RuntimeType(lambdaType)), "Lambda::fromFunction");
-	return Lambda(lambdaFunctionSignature, lambdaType, lambdaNotation, lambdaFunction);
+
+	// the bytecode runs intrinsics on bare numbers, only Number returning lambdas may claim one.
+	const RuntimeType returnType{ RuntimeCompoundType::_getLambdaReturnType(lambdaType) };
+	if (const RuntimeBaseType* baseType{ std::get_if<RuntimeBaseType>(&returnType) }; !baseType || *baseType != RuntimeBaseType::Number)
+		intrinsic = Intrinsic::None;
+
+	return Lambda(lambdaFunctionSignature, lambdaType, lambdaNotation, lambdaFunction, intrinsic);
 }
 
 inline Result<Lambda, std::runtime_error> Lambda::fromFunction(
@@ -106,7 +120,7 @@ inline Result<Lambda, std::runtime_error> Lambda::fromFunction(
 {
 	if (lambdaNotation == LambdaNotation::Infix &&
 		(lambdaType.Type != RuntimeBaseType::_Lambda ||
-			std::get_if<RuntimeCompoundType>(&lambdaType.Children[1])->Type != RuntimeBaseType::_Storage ||
+			std::get_if<RuntimeCompoundType>(&lambdaType.getChildren()[1])->Type != RuntimeBaseType::_Storage ||
 			RuntimeCompoundType::_getLambdaParamsNumbers(lambdaType) != 2))
 		return RuntimeError<RuntimeTypeError>(std::format("Lambda Infix LambdaNotation must be a Storage with 2 argument. (cannot be \"{}\")", RuntimeType(lambdaType)), "Lambda::fromFunction");
 
@@ -145,7 +159,7 @@ inline Result<Lambda, std::runtime_error> Lambda::fromFunction(
 
 inline Result<Lambda, std::runtime_error> Lambda::fromExpressionNode(
 	NodePos lambdaFunctionRootNode,
-	const std::unordered_map<std::string, Lambda>& EvaluatorLambdaFunctions)
+	const EvaluatorScope& EvaluatorLambdaFunctions)
 {
 	if (!NodeFactory::validNode(lambdaFunctionRootNode))
 		return RuntimeError<RuntimeTypeError>("The conversion from NodeExpression to Lambda failed due to an invalid NodeExpression.",
@@ -158,12 +172,12 @@ inline Result<Lambda, std::runtime_error> Lambda::fromExpressionNode(
 			return RuntimeError<RuntimeTypeError>(
 				returnTypeRaw.getException(),
 				std::format("While determining type of lambdaFunctionRootNode \"{}\"",
-					NodeFactory::node(lambdaFunctionRootNode).value),
+					NodeFactory::node(lambdaFunctionRootNode).value()),
 				"Lambda::fromExpressionNode");
 
 		std::vector<RuntimeType> parameterTypes;
-		parameterTypes.reserve(NodeFactory::node(lambdaFunctionRootNode).utilityStorage.size());
-		for (const auto& [_, parameterType] : NodeFactory::node(lambdaFunctionRootNode).utilityStorage)
+		parameterTypes.reserve(NodeFactory::node(lambdaFunctionRootNode).utilityStorage().size());
+		for (const auto& [_, parameterType] : NodeFactory::node(lambdaFunctionRootNode).utilityStorage())
 			parameterTypes.emplace_back(parameterType);
 
 		return Lambda(
@@ -174,12 +188,12 @@ inline Result<Lambda, std::runtime_error> Lambda::fromExpressionNode(
 	}
 
 	else if (NodeFactory::node(lambdaFunctionRootNode).nodestate == NodeFactory::Node::NodeState::Operator) {
-		if (EvaluatorLambdaFunctions.contains(NodeFactory::node(lambdaFunctionRootNode).value))
-			return EvaluatorLambdaFunctions.at(NodeFactory::node(lambdaFunctionRootNode).value);
+		if (EvaluatorLambdaFunctions.contains(NodeFactory::node(lambdaFunctionRootNode).value()))
+			return EvaluatorLambdaFunctions.at(NodeFactory::node(lambdaFunctionRootNode).value());
 
 		return RuntimeError<LambdaConstructionError>(
 			std::format("The LambdaSignature \"{}\" not found in EvaluatorLambdaFunctions",
-				NodeFactory::node(lambdaFunctionRootNode).value),
+				NodeFactory::node(lambdaFunctionRootNode).value()),
 			"Lambda::fromExpressionNode");
 	}
 	return RuntimeError<LambdaConstructionError>(
@@ -188,6 +202,16 @@ inline Result<Lambda, std::runtime_error> Lambda::fromExpressionNode(
 		"Lambda::fromExpressionNode");
 }
 
+inline std::optional<std::vector<long double>> Lambda::evaluateBatch(const EvaluatorScope& EvaluatorLambdaFunctions, std::span<const long double> arguments) const {
+	const std::optional<Bytecode> bytecode{ Bytecode::compileBatch(*this, EvaluatorLambdaFunctions) };
+	if (!bytecode)
+		return std::nullopt;
+
+	std::vector<long double> results(arguments.size());
+	bytecode->runBatch(arguments, results);
+	return results;
+}
+
 inline Result<NodeFactory::NodePos, std::runtime_error> Lambda::getExpressionTree(const LambdaArguments& arguments) const {
 	if (!_fastCheckRuntimeTypeArgumentsType(*mLambdaInfo.ParamsType, arguments))
 		return std::runtime_error(std::format("Lambda parameter and argument not matched. ({} != {})", *mLambdaInfo.ParamsType, Storage::fromVector(arguments).getType()));
@@ -231,6 +255,10 @@ inline Lambda::LambdaNotation Lambda::getNotation() const {
 	return mLambdaNotation;
 }
 
+inline Lambda::Intrinsic Lambda::getIntrinsic() const {
+	return mIntrinsic;
+}
+
 inline std::string Lambda::toString() const {
 	std::ostringstream ss;
 	ss << getType();
@@ -246,27 +274,66 @@ inline NodeFactory::NodePos Lambda::generateExpressionTree() const {
 	return operatorNode;
 }
 
+// the types getReturnType annotated on a node whose child is replaced and on the nodes above it no longer hold.
 static void findAndReplaceConstant(NodeFactory::NodePos root, const std::unordered_map<std::string, NodeFactory::NodePos>& replacement) {
-	std::stack<NodeFactory::NodePos> nodes;
-	nodes.push(root);
+	std::stack<std::pair<NodeFactory::NodePos, size_t>> nodes; // node, depth
+	std::vector<NodeFactory::NodePos> path; // the nodes from root down to the current one.
+	nodes.emplace(root, 0);
 
 	while (!nodes.empty()) {
-		NodeFactory::NodePos currNode{ nodes.top() }; nodes.pop();
+		const auto [currNode, depth] { nodes.top() }; nodes.pop();
+		path.resize(depth);
+		path.emplace_back(currNode);
+
+		bool replaced{ false };
 		if (NodeFactory::validNode(NodeFactory::node(currNode).leftPos)) {
-			nodes.push(NodeFactory::node(currNode).leftPos);
-			if (replacement.contains(NodeFactory::node(currNode).leftNode().value))
-				NodeFactory::node(currNode).leftPos = replacement.at(NodeFactory::node(currNode).leftNode().value);
+			nodes.emplace(NodeFactory::node(currNode).leftPos, depth + 1);
+			if (replacement.contains(NodeFactory::node(currNode).leftNode().value())) {
+				NodeFactory::node(currNode).leftPos = replacement.at(NodeFactory::node(currNode).leftNode().value());
+				replaced = true;
+			}
 		}
 
 		if (NodeFactory::validNode(NodeFactory::node(currNode).rightPos)) {
-			nodes.push(NodeFactory::node(currNode).rightPos);
-			if (replacement.contains(NodeFactory::node(currNode).rightNode().value))
-				NodeFactory::node(currNode).rightPos = replacement.at(NodeFactory::node(currNode).rightNode().value);
+			nodes.emplace(NodeFactory::node(currNode).rightPos, depth + 1);
+			if (replacement.contains(NodeFactory::node(currNode).rightNode().value())) {
+				NodeFactory::node(currNode).rightPos = replacement.at(NodeFactory::node(currNode).rightNode().value());
+				replaced = true;
+			}
 		}
+
+		if (replaced)
+			for (const NodeFactory::NodePos pathNode : path) {
+				NodeFactory::node(pathNode).clearType();
+				NodeFactory::node(pathNode).clearProgram();
+			}
 	}
 }
 
-inline Result<RuntimeTypedExprComponent, std::runtime_error> Lambda::evaluate(const std::unordered_map<std::string, Lambda>& EvaluatorLambdaFunctions, const LambdaArguments& arguments) const {
+// the argument a parser-resolved parameter leaf refers to, nullptr for every other node.
+static const RuntimeTypedExprComponent* parameterArgument(NodeFactory::NodePos nodePos, const EvaluatorScope& EvaluatorLambdaFunctions) {
+	const NodeFactory::Node currNode{ NodeFactory::node(nodePos) };
+	if (!currNode.isParameter())
+		return nullptr;
+	return EvaluatorLambdaFunctions.argument(currNode.parameterSlot(), currNode.value());
+}
+
+// whether a value of this type can keep referring to nodes after it is returned (lambda bodies, node pointers).
+static bool holdsNodeReference(const RuntimeType& type) {
+	if (std::holds_alternative<RuntimeEvaluate>(type))
+		return true;
+
+	if (const RuntimeBaseType* baseType{ std::get_if<RuntimeBaseType>(&type) }; baseType)
+		return *baseType == RuntimeBaseType::NodePointer || *baseType == RuntimeBaseType::_Lambda;
+
+	const RuntimeCompoundType& compoundType{ std::get<RuntimeCompoundType>(type) };
+	if (compoundType.Type == RuntimeBaseType::_Lambda)
+		return true;
+
+	return std::ranges::any_of(compoundType.getChildren(), [](const RuntimeType& child) { return holdsNodeReference(child); });
+}
+
+inline Result<RuntimeTypedExprComponent, std::runtime_error> Lambda::evaluate(const EvaluatorScope& EvaluatorLambdaFunctions, const LambdaArguments& arguments) const {
 	if (arguments.size() != mLambdaInfo.ParamsNumbers)
 		return RuntimeError<RuntimeTypeError>(
 			std::format(
@@ -310,56 +377,45 @@ inline Result<RuntimeTypedExprComponent, std::runtime_error> Lambda::evaluate(co
 		}
 	}
 
+	if (!NodeFactory::validNode(std::get<NodePos>(mLambdaFunction)))
+		return RuntimeError<LambdaEvaluationError>(
+			std::format(
+				"The lambda function node \"{}\" is stale, it was released by the NodeFactory.",
+				std::get<NodePos>(mLambdaFunction)
+			),
+			"Lambda::evaluate"
+		);
+
 	bool returnValueNeedConstantReplacement = (std::holds_alternative<RuntimeCompoundType>(*mLambdaInfo.ReturnType) && std::get<RuntimeCompoundType>(*mLambdaInfo.ReturnType).Type == RuntimeBaseType::_Lambda);
 
-	std::unordered_map<std::string, Lambda> evaluatorLambdaFunctionsSnapshot(EvaluatorLambdaFunctions);
-	std::unordered_map<std::string, NodePos> parameterConstantsReplacement;
+	// the body is folded on the first call, the constant replacement below rewrites it on every call instead.
+	if (!returnValueNeedConstantReplacement)
+		Optimizer::foldLambda(std::get<NodePos>(mLambdaFunction), EvaluatorLambdaFunctions);
+
+	// nodes created while evaluating the body are garbage unless the result can refer to them.
+	std::optional<NodeFactory::ScopedRegion> evaluationRegion;
+	if (!returnValueNeedConstantReplacement && !holdsNodeReference(*mLambdaInfo.ReturnType))
+		evaluationRegion.emplace();
 
 	const std::vector<std::pair<std::string, RuntimeType>>& parameters{
-		NodeFactory::node(std::get<NodePos>(mLambdaFunction)).utilityStorage
+		NodeFactory::node(std::get<NodePos>(mLambdaFunction)).utilityStorage()
 	}; // allowed, usage doesn't involve recusive function such as Lambda::evaluate or Lambda::_NodeExpressionEvaluate
 
-	for (size_t ind{ 0 }, len{ parameters.size() }; ind < len; ind++) {
-		auto constLambda = [arguments, ind](const Lambda::LambdaArguments&) {
-			return arguments[ind];
-			};
-
-		Result<Lambda, std::runtime_error> tempFunc{
-			Lambda::fromFunction(
-				parameters[ind].first,
-				RuntimeCompoundType::Lambda(
-					parameters[ind].second,
-					RuntimeBaseType::_Storage
-				),
-				Lambda::LambdaNotation::Constant,
-				constLambda
-			)
-		};
-
-		if (tempFunc.isError())
-			return RuntimeError<LambdaConstructionError>(
-				tempFunc.getException(),
-				std::format(
-					"When attempting to create a constant lambda function \"{}\", which is used for determine lambda function evaluation result .",
-					parameters[ind].first
-				),
-				"Lambda::evaluate"
-			);
+	// the arguments are a frame on top of the caller's scope, parameter references read them by slot.
+	EvaluatorScope callScope{ EvaluatorScope::frame(EvaluatorLambdaFunctions, parameters, &arguments) };
 
-		if (returnValueNeedConstantReplacement)
+	std::unordered_map<std::string, NodePos> parameterConstantsReplacement;
+	if (returnValueNeedConstantReplacement)
+		for (size_t ind{ 0 }, len{ parameters.size() }; ind < len; ind++)
 			parameterConstantsReplacement.try_emplace(parameters[ind].first, arguments[ind].toNodeExpression());
 
-		evaluatorLambdaFunctionsSnapshot.try_emplace(parameters[ind].first, tempFunc.moveValue());
-	}
-
 	if (returnValueNeedConstantReplacement)
 		findAndReplaceConstant(std::get<NodePos>(mLambdaFunction), parameterConstantsReplacement);
 
 	Result<RuntimeTypedExprComponent, std::runtime_error>&& res{
-		_NodeExpressionEvaluate(
-			std::get<NodePos>(mLambdaFunction),
-			evaluatorLambdaFunctionsSnapshot
-		)
+		returnValueNeedConstantReplacement
+		? _NodeExpressionEvaluate(std::get<NodePos>(mLambdaFunction), callScope)
+		: _NodeBodyEvaluate(std::get<NodePos>(mLambdaFunction), callScope)
 	};
 
 	if (res.isError())
@@ -368,7 +424,7 @@ inline Result<RuntimeTypedExprComponent, std::runtime_error> Lambda::evaluate(co
 			std::format(
 				"When attempting to evaluate lambda function on node \"{}\" (value={})",
 				NodeFactory::node(std::get<NodePos>(mLambdaFunction)).leftPos,
-				NodeFactory::node(std::get<NodePos>(mLambdaFunction)).value
+				NodeFactory::node(std::get<NodePos>(mLambdaFunction)).value()
 			),
 			"Lambda::evaluate"
 		);
@@ -378,7 +434,7 @@ inline Result<RuntimeTypedExprComponent, std::runtime_error> Lambda::evaluate(co
 }
 
 template<RuntimeTypedExprComponentRequired ...Args>
-inline Result<RuntimeTypedExprComponent, std::runtime_error> Lambda::evaluate(const std::unordered_map<std::string, Lambda>& EvaluatorLambdaFunctions, Args&&... arguments) const {
+inline Result<RuntimeTypedExprComponent, std::runtime_error> Lambda::evaluate(const EvaluatorScope& EvaluatorLambdaFunctions, Args&&... arguments) const {
 	constexpr size_t count = sizeof...(arguments);
 	std::vector<RuntimeTypedExprComponent> tmp;
 	tmp.reserve(count);
@@ -391,14 +447,20 @@ static bool isLeafNode(NodeFactory::NodePos nodePos) {
 	return (!NodeFactory::validNode(NodeFactory::node(nodePos).leftPos) && !NodeFactory::validNode(NodeFactory::node(nodePos).rightPos));
 }
 
-inline Result<std::vector<RuntimeTypedExprComponent>, std::runtime_error> Lambda::_NodeExpressionsEvaluator(std::vector<NodePos> rootNodeExpressions, const std::unordered_map<std::string, Lambda>& EvaluatorLambdaFunctions) {
+inline Result<std::vector<RuntimeTypedExprComponent>, std::runtime_error> Lambda::_NodeExpressionsEvaluator(std::vector<NodePos> rootNodeExpressions, const EvaluatorScope& EvaluatorLambdaFunctions) {
 	std::vector<RuntimeTypedExprComponent> evaluationResults;
 
 	std::ranges::reverse(rootNodeExpressions);
 
 	while (!rootNodeExpressions.empty()) {
 		NodePos currNode = rootNodeExpressions.back(); rootNodeExpressions.pop_back();
-		NodeFactory::Node currNodeNode = NodeFactory::node(currNode);
+
+		// a bare parameter stands for its argument, not for a lambda returning it.
+		if (const RuntimeTypedExprComponent* argument{ parameterArgument(currNode, EvaluatorLambdaFunctions) }) {
+			evaluationResults.emplace_back(*argument);
+			continue;
+		}
+
 		if (NodeFactory::node(currNode).nodestate == NodeFactory::Node::NodeState::LambdaFuntion ||
 			(NodeFactory::node(currNode).nodestate == NodeFactory::Node::NodeState::Operator && isLeafNode(currNode))) {
 			Result<Lambda, std::runtime_error> lambdaFunctionResult{ Lambda::fromExpressionNode(currNode, EvaluatorLambdaFunctions) };
@@ -407,7 +469,7 @@ inline Result<std::vector<RuntimeTypedExprComponent>, std::runtime_error> Lambda
 					lambdaFunctionResult.getException(),
 					std::format(
 						"When attempting to convert a NodeExpression into a lambda function for evaluation. (nodeExpression value = {})",
-						NodeFactory::validNode(currNode) ? NodeFactory::node(currNode).value : "Null"
+						NodeFactory::validNode(currNode) ? NodeFactory::node(currNode).value() : "Null"
 					),
 					"Lambda::_NodeExpressionsEvaluator"
 				);
@@ -450,7 +512,7 @@ inline Result<std::vector<RuntimeTypedExprComponent>, std::runtime_error> Lambda
 					storageResult.getException(),
 					std::format(
 						"When attempting to convert a NodeExpression into a storage for evaluation. (nodeExpression value = {})",
-						NodeFactory::validNode(currNode) ? NodeFactory::node(currNode).value : "Null"
+						NodeFactory::validNode(currNode) ? NodeFactory::node(currNode).value() : "Null"
 					),
 					"Lambda::_NodeExpressionsEvaluator"
 				);
@@ -527,7 +589,7 @@ inline Result<std::vector<RuntimeTypedExprComponent>, std::runtime_error> Lambda
 				evaluationResult.getException(),
 				std::format(
 					"When attempting to evaluate the NodeExpression. (nodeExpression value = {})",
-					NodeFactory::validNode(currNode) ? NodeFactory::node(currNode).value : "Null"
+					NodeFactory::validNode(currNode) ? NodeFactory::node(currNode).value() : "Null"
 				),
 				"Lambda::_NodeExpressionsEvaluator"
 			);
@@ -617,9 +679,184 @@ inline Result<std::vector<RuntimeTypedExprComponent>, std::runtime_error> Lambda
 	return evaluationResults;
 }
 
+inline Result<RuntimeTypedExprComponent, std::runtime_error> Lambda::_applyInfix(
+	const Lambda& lambdaFunction,
+	RuntimeTypedExprComponent& leftVal,
+	RuntimeTypedExprComponent& rightVal,
+	const EvaluatorScope& EvaluatorLambdaFunctions
+) {
+	const auto& parametersType{
+		RuntimeCompoundType::getStorageInfo(
+			*lambdaFunction.getLambdaInfo().ParamsType
+		).Storage
+	};
+
+	// implicit convert to nodePointer
+	if ((*parametersType)[0] == RuntimeBaseType::NodePointer)
+		leftVal = NodePointer(leftVal.toNodeExpression());
+
+	// implicit convert to nodePointer
+	if ((*parametersType)[1] == RuntimeBaseType::NodePointer)
+		rightVal = NodePointer(rightVal.toNodeExpression());
+
+	if (!((*parametersType)[0] == leftVal.getDetailTypeHold() &&
+		(*parametersType)[1] == rightVal.getDetailTypeHold()))
+		return RuntimeError<RuntimeTypeError>(
+			std::format(
+				"Parameters type must be same as to argument type. ({} != {})",
+				*lambdaFunction.getLambdaInfo().ParamsType,
+				RuntimeType(
+					RuntimeCompoundType::gurantreeNoRuntimeEvaluateStorage({
+						leftVal.getDetailTypeHold(),
+						rightVal.getDetailTypeHold()
+						})
+				)
+			),
+			"Lambda::_NodeExpressionEvaluate"
+		);
+
+	Result<RuntimeTypedExprComponent, std::runtime_error>&& infixOperatorResult{
+		lambdaFunction.evaluate(EvaluatorLambdaFunctions, std::move(leftVal), std::move(rightVal))
+	};
+
+	if (infixOperatorResult.isError())
+		return RuntimeError<LambdaEvaluationError>(
+			infixOperatorResult.getException(),
+			std::format(
+				"When attempting to evaluate the infix lambda function. (left nodeExpression value = {}, right nodeExpression value = {})",
+				leftVal,
+				rightVal
+			),
+			"Lambda::_NodeExpressionEvaluate"
+		);
+
+	return infixOperatorResult.moveValue();
+}
+
+inline Result<RuntimeTypedExprComponent, std::runtime_error> Lambda::_applyPostfix(
+	const Lambda& lambdaFunction,
+	RuntimeTypedExprComponent& rightVal,
+	const EvaluatorScope& EvaluatorLambdaFunctions
+) {
+	// implicit convert to nodePointer
+	if (*lambdaFunction.getLambdaInfo().ParamsType == RuntimeBaseType::NodePointer)
+		rightVal = NodePointer(rightVal.toNodeExpression());
+
+	if (*lambdaFunction.getLambdaInfo().ParamsType != rightVal.getDetailTypeHold())
+		return RuntimeError<RuntimeTypeError>(
+			std::format(
+				"Parameters type must be equal to argument type. ({} != {})",
+				*lambdaFunction.getLambdaInfo().ParamsType,
+				rightVal.getDetailTypeHold()
+			),
+			"Lambda::_NodeExpressionEvaluate"
+		);
+
+	Result<RuntimeTypedExprComponent, std::runtime_error>&& postfixOperatorResult{
+		lambdaFunction.evaluate(EvaluatorLambdaFunctions, std::move(rightVal))
+	};
+
+	if (postfixOperatorResult.isError())
+		return RuntimeError<LambdaEvaluationError>(
+			postfixOperatorResult.getException(),
+			std::format(
+				"When attempting to evaluate the postfix lambda function. (right nodeExpression value = {})",
+				rightVal
+			),
+			"Lambda::_NodeExpressionEvaluate"
+		);
+
+	return postfixOperatorResult.moveValue();
+}
+
+inline Result<RuntimeTypedExprComponent, std::runtime_error> Lambda::_applyPrefix(
+	const Lambda& lambdaFunction,
+	RuntimeTypedExprComponent& leftVal,
+	const EvaluatorScope& EvaluatorLambdaFunctions
+) {
+	// implicit convert to nodePointer
+	if (*lambdaFunction.getLambdaInfo().ParamsType == RuntimeBaseType::NodePointer)
+		leftVal = NodePointer(leftVal.toNodeExpression());
+
+	if (*lambdaFunction.getLambdaInfo().ParamsType != leftVal.getDetailTypeHold())
+		return RuntimeError<RuntimeTypeError>(
+			std::format(
+				"Parameters type must be equal to argument type. ({} != {})",
+				*lambdaFunction.getLambdaInfo().ParamsType,
+				leftVal.getDetailTypeHold()
+			)
+		);
+
+	Result<RuntimeTypedExprComponent, std::runtime_error>&& prefixOperatorResult{
+		lambdaFunction.evaluate(EvaluatorLambdaFunctions, std::move(leftVal))
+	};
+
+	if (prefixOperatorResult.isError())
+		return RuntimeError<LambdaEvaluationError>(
+			prefixOperatorResult.getException(),
+			std::format(
+				"When attempting to evaluate the prefix lambda function. (left nodeExpression value = {})",
+				leftVal
+			),
+			"Lambda::_NodeExpressionEvaluate"
+		);
+
+	return prefixOperatorResult.moveValue();
+}
+
 inline Result<RuntimeTypedExprComponent, std::runtime_error> Lambda::_NodeExpressionEvaluate(
 	NodePos rootNodeExpression,
-	const std::unordered_map<std::string, Lambda>& EvaluatorLambdaFunctions
+	const EvaluatorScope& EvaluatorLambdaFunctions
+) {
+	return Bytecode::compile(rootNodeExpression, EvaluatorLambdaFunctions).run(EvaluatorLambdaFunctions);
+}
+
+// the program of a body made of one expression is kept on the lambda node, later calls only load their arguments.
+// Bodies the expression evaluator doesn't simply evaluate (several expressions, lambda literals, storages, ...) take the tree walker.
+inline Result<RuntimeTypedExprComponent, std::runtime_error> Lambda::_NodeBodyEvaluate(
+	NodePos lambdaNode,
+	const EvaluatorScope& EvaluatorLambdaFunctions
+) {
+	const NodeFactory::Node lambdaFunctionNode{ NodeFactory::node(lambdaNode) };
+	const NodePos bodyNode{ lambdaFunctionNode.leftPos };
+	if (NodeFactory::validNode(lambdaFunctionNode.rightPos) || !NodeFactory::validNode(bodyNode) ||
+		NodeFactory::node(bodyNode).nodestate == NodeFactory::Node::NodeState::LambdaFuntion ||
+		NodeFactory::node(bodyNode).nodestate == NodeFactory::Node::NodeState::Storage ||
+		(NodeFactory::node(bodyNode).nodestate == NodeFactory::Node::NodeState::Operator && isLeafNode(bodyNode)) ||
+		parameterArgument(bodyNode, EvaluatorLambdaFunctions))
+		return _NodeExpressionEvaluate(lambdaNode, EvaluatorLambdaFunctions);
+
+	std::shared_ptr<const Bytecode> program{ lambdaFunctionNode.program() }; // kept alive should the call rewrite the body.
+	if (!program || !program->reusable(EvaluatorLambdaFunctions)) {
+		program = std::make_shared<const Bytecode>(Bytecode::compile(bodyNode, EvaluatorLambdaFunctions));
+		if (program->reusable(EvaluatorLambdaFunctions))
+			NodeFactory::node(lambdaNode).setProgram(program);
+	}
+
+	Result<RuntimeTypedExprComponent, std::runtime_error>&& result{ program->run(EvaluatorLambdaFunctions) };
+	if (result.isError())
+		return RuntimeError<LambdaEvaluationError>(
+			RuntimeError<LambdaEvaluationError>(
+				result.getException(),
+				std::format(
+					"When attempting to evaluate the NodeExpression. (nodeExpression value = {})",
+					NodeFactory::node(bodyNode).value()
+				),
+				"Lambda::_NodeExpressionsEvaluator"
+			),
+			std::format(
+				"When attempting to evaluate expession content of a lambda function. (value = {})",
+				NodeFactory::node(bodyNode).value()
+			),
+			"Lambda::_NodeExpressionEvaluate"
+		);
+
+	return result;
+}
+
+inline Result<RuntimeTypedExprComponent, std::runtime_error> Lambda::_NodeExpressionTreeWalk(
+	NodePos rootNodeExpression,
+	const EvaluatorScope& EvaluatorLambdaFunctions
 ) {
 	std::stack<NodeFactory::NodePos> operationStack;
 	std::unordered_map<NodeFactory::NodePos, std::optional<RuntimeTypedExprComponent>> resultMap;
@@ -633,30 +870,36 @@ inline Result<RuntimeTypedExprComponent, std::runtime_error> Lambda::_NodeExpres
 			continue;
 		}
 
-		NodeFactory::Node* currNode{ &NodeFactory::node(currNodePos) };
+		std::optional<NodeFactory::Node> currNode{ NodeFactory::node(currNodePos) };
 
 		// if currNode is a leaf node.
 		if (!NodeFactory::validNode(currNode->rightPos) &&
 			!NodeFactory::validNode(currNode->leftPos)) {
-			if (currNode->value == "." || currNode->value == "-.")
+			if (currNode->isNumber())
+				resultMap[currNodePos] = currNode->number();
+
+			else if (currNode->value() == "." || currNode->value() == "-.")
 				resultMap[currNodePos] = 0;
 
 			else if (currNode->nodestate == NodeFactory::Node::NodeState::Storage)
 				resultMap[currNodePos] = Storage::NullStorage();
 
-			else if (EvaluatorLambdaFunctions.contains(currNode->value) &&
-				EvaluatorLambdaFunctions.at(currNode->value).getNotation() == Lambda::LambdaNotation::Constant) {
-				Lambda constOperator{ EvaluatorLambdaFunctions.at(currNode->value) };
+			else if (const RuntimeTypedExprComponent* argument{ parameterArgument(currNodePos, EvaluatorLambdaFunctions) })
+				resultMap[currNodePos] = *argument;
+
+			else if (EvaluatorLambdaFunctions.contains(currNode->value()) &&
+				EvaluatorLambdaFunctions.at(currNode->value()).getNotation() == Lambda::LambdaNotation::Constant) {
+				Lambda constOperator{ EvaluatorLambdaFunctions.at(currNode->value()) };
 				Result<RuntimeTypedExprComponent, std::runtime_error>&& constOperatorResult{ constOperator.evaluate(EvaluatorLambdaFunctions, {}) };
 
-				currNode = &NodeFactory::node(currNodePos); // update currNode, evaluate can change currNode address.
+				currNode.emplace(NodeFactory::node(currNodePos)); // update currNode, evaluate can move the node columns.
 
 				if (constOperatorResult.isError())
 					return RuntimeError<LambdaEvaluationError>(
 						constOperatorResult.getException(),
 						std::format(
 							"When attempting to evaluate the constant lambda function with leaf node constant operator evaluation. (constant operator nodeExpression value = {})",
-							currNode->value
+							currNode->value()
 						),
 						"Lambda::_NodeExpressionEvaluate"
 					);
@@ -664,14 +907,14 @@ inline Result<RuntimeTypedExprComponent, std::runtime_error> Lambda::_NodeExpres
 				resultMap[currNodePos] = constOperatorResult.moveValue();
 			}
 			else
-				resultMap[currNodePos] = std::stold(currNode->value);
+				resultMap[currNodePos] = parseNumberPrefix(currNode->value());
 		}
 
 		else if (currNode->nodestate == NodeFactory::Node::NodeState::LambdaFuntion) {
 			std::vector<NodeFactory::NodePos> expressions;
 
 			bool evalutateState = true;
-			for (const auto& [parameterName, _] : currNode->utilityStorage)
+			for (const auto& [parameterName, _] : currNode->utilityStorage())
 				evalutateState = evalutateState && EvaluatorLambdaFunctions.contains(parameterName);
 
 			if (!evalutateState) {
@@ -684,7 +927,7 @@ inline Result<RuntimeTypedExprComponent, std::runtime_error> Lambda::_NodeExpres
 						lambdaFunctionResult.getException(),
 						std::format(
 							"When attempting to convert a NodeExpression into a lambda function for evaluation. (nodeExpression value = {})",
-							currNode->value
+							currNode->value()
 						),
 						"Lambda::_NodeExpressionsEvaluator"
 					);
@@ -709,7 +952,7 @@ inline Result<RuntimeTypedExprComponent, std::runtime_error> Lambda::_NodeExpres
 						std::format(
 							"When attempting to evaluate expession content of a lambda function. (value = {})",
 							(NodeFactory::validNode(NodeFactory::node(currNodePos).leftPos)
-								? NodeFactory::node(currNodePos).leftNode().value
+								? NodeFactory::node(currNodePos).leftNode().value()
 								: "Null")
 						),
 						"Lambda::_NodeExpressionEvaluate"
@@ -737,7 +980,7 @@ inline Result<RuntimeTypedExprComponent, std::runtime_error> Lambda::_NodeExpres
 						std::format(
 							"When attempting to evaluate an argument. (value = {})",
 							NodeFactory::validNode(NodeFactory::node(currArgNodePos).leftPos)
-							? NodeFactory::node(currArgNodePos).leftNode().value
+							? NodeFactory::node(currArgNodePos).leftNode().value()
 							: "Null"),
 						"Lambda::_NodeExpressionEvaluate"
 					);
@@ -752,8 +995,8 @@ inline Result<RuntimeTypedExprComponent, std::runtime_error> Lambda::_NodeExpres
 			resultMap[currNodePos] = Storage::fromVector(std::move(arguments));
 		}
 
-		else if (EvaluatorLambdaFunctions.contains(currNode->value) &&
-			EvaluatorLambdaFunctions.at(currNode->value).getNotation() == Lambda::LambdaNotation::Infix) {
+		else if (EvaluatorLambdaFunctions.contains(currNode->value()) &&
+			EvaluatorLambdaFunctions.at(currNode->value()).getNotation() == Lambda::LambdaNotation::Infix) {
 			if (!resultMap.contains(currNode->leftPos)) {
 				operationStack.push(currNode->leftPos);
 				continue;
@@ -764,136 +1007,71 @@ inline Result<RuntimeTypedExprComponent, std::runtime_error> Lambda::_NodeExpres
 				continue;
 			}
 
-			RuntimeTypedExprComponent&& leftVal{ std::move(resultMap[currNode->leftPos].value()) };
-			RuntimeTypedExprComponent&& rightVal{ std::move(resultMap[currNode->rightPos].value()) };
-
-			const Lambda& lambdaFunction{ EvaluatorLambdaFunctions.at(currNode->value) };
-			const auto& parametersType{
-				RuntimeCompoundType::getStorageInfo(
-					*lambdaFunction.getLambdaInfo().ParamsType
-				).Storage
-			};
-
-			// implicit convert to nodePointer
-			if ((*parametersType)[0] == RuntimeBaseType::NodePointer)
-				leftVal = NodePointer(leftVal.toNodeExpression());
-
-			// implicit convert to nodePointer
-			if ((*parametersType)[1] == RuntimeBaseType::NodePointer)
-				rightVal = NodePointer(rightVal.toNodeExpression());
-				
-			if (!((*parametersType)[0] == leftVal.getDetailTypeHold() &&
-				(*parametersType)[1] == rightVal.getDetailTypeHold()))
-				return RuntimeError<RuntimeTypeError>(
-					std::format(
-						"Parameters type must be same as to argument type. ({} != {})",
-						*lambdaFunction.getLambdaInfo().ParamsType,
-						RuntimeType(
-							RuntimeCompoundType::gurantreeNoRuntimeEvaluateStorage({
-								leftVal.getDetailTypeHold(),
-								rightVal.getDetailTypeHold()
-								})
-						)
-					),
-					"Lambda::_NodeExpressionEvaluate"
-				);
-
 			Result<RuntimeTypedExprComponent, std::runtime_error>&& infixOperatorResult{
-				lambdaFunction.evaluate(EvaluatorLambdaFunctions, std::move(leftVal), std::move(rightVal))
+				_applyInfix(
+					EvaluatorLambdaFunctions.at(currNode->value()),
+					resultMap[currNode->leftPos].value(),
+					resultMap[currNode->rightPos].value(),
+					EvaluatorLambdaFunctions
+				)
 			};
 
 			if (infixOperatorResult.isError())
-				return RuntimeError<LambdaEvaluationError>(
-					infixOperatorResult.getException(),
-					std::format(
-						"When attempting to evaluate the infix lambda function. (left nodeExpression value = {}, right nodeExpression value = {})",
-						resultMap[currNode->leftPos].value(),
-						resultMap[currNode->rightPos].value()
-					),
-					"Lambda::_NodeExpressionEvaluate"
-				);
+				return infixOperatorResult.getException();
+
+			currNode.emplace(NodeFactory::node(currNodePos)); // evaluate can move the node columns.
 
+			// operands are consumed, keep resultMap as small as the pending part of the tree.
+			resultMap.erase(currNode->leftPos);
+			resultMap.erase(currNode->rightPos);
 			resultMap[currNodePos] = infixOperatorResult.moveValue();
 		}
 
-		else if (EvaluatorLambdaFunctions.contains(currNode->value) &&
-			EvaluatorLambdaFunctions.at(currNode->value).getNotation() == Lambda::LambdaNotation::Postfix) {
+		else if (EvaluatorLambdaFunctions.contains(currNode->value()) &&
+			EvaluatorLambdaFunctions.at(currNode->value()).getNotation() == Lambda::LambdaNotation::Postfix) {
 			if (!resultMap.contains(currNode->rightPos)) {
 				operationStack.push(currNode->rightPos);
 				continue;
 			}
 
-			RuntimeTypedExprComponent&& rightVal{ std::move(resultMap[currNode->rightPos].value()) };
-			const Lambda& lambdaFunction = EvaluatorLambdaFunctions.at(currNode->value);
-
-			// implicit convert to nodePointer
-			if (*lambdaFunction.getLambdaInfo().ParamsType == RuntimeBaseType::NodePointer)
-				rightVal = NodePointer(rightVal.toNodeExpression());
-
-			if (*lambdaFunction.getLambdaInfo().ParamsType != rightVal.getDetailTypeHold())
-				return RuntimeError<RuntimeTypeError>(
-					std::format(
-						"Parameters type must be equal to argument type. ({} != {})",
-						*lambdaFunction.getLambdaInfo().ParamsType,
-						rightVal.getDetailTypeHold()
-					),
-					"Lambda::_NodeExpressionEvaluate"
-				);
-
 			Result<RuntimeTypedExprComponent, std::runtime_error>&& postfixOperatorResult{
-				lambdaFunction.evaluate(EvaluatorLambdaFunctions, std::move(rightVal))
+				_applyPostfix(
+					EvaluatorLambdaFunctions.at(currNode->value()),
+					resultMap[currNode->rightPos].value(),
+					EvaluatorLambdaFunctions
+				)
 			};
 
 			if (postfixOperatorResult.isError())
-				return RuntimeError<LambdaEvaluationError>(
-					postfixOperatorResult.getException(),
-					std::format(
-						"When attempting to evaluate the postfix lambda function. (right nodeExpression value = {})",
-						resultMap[currNode->rightPos].value()
-					),
-					"Lambda::_NodeExpressionEvaluate"
-				);
+				return postfixOperatorResult.getException();
+
+			currNode.emplace(NodeFactory::node(currNodePos)); // evaluate can move the node columns.
 
+			resultMap.erase(currNode->rightPos);
 			resultMap[currNodePos] = postfixOperatorResult.moveValue();
 		}
 
-		else if (EvaluatorLambdaFunctions.contains(currNode->value) &&
-			EvaluatorLambdaFunctions.at(currNode->value).getNotation() == Lambda::LambdaNotation::Prefix) {
+		else if (EvaluatorLambdaFunctions.contains(currNode->value()) &&
+			EvaluatorLambdaFunctions.at(currNode->value()).getNotation() == Lambda::LambdaNotation::Prefix) {
 			if (!resultMap.contains(currNode->leftPos)) {
 				operationStack.push(currNode->leftPos);
 				continue;
 			}
 
-			RuntimeTypedExprComponent&& leftVal{ std::move(resultMap[currNode->leftPos].value()) };
-			const Lambda& lambdaFunction{ EvaluatorLambdaFunctions.at(currNode->value) };
-
-			// implicit convert to nodePointer
-			if (*lambdaFunction.getLambdaInfo().ParamsType == RuntimeBaseType::NodePointer)
-				leftVal = NodePointer(leftVal.toNodeExpression());
-
-			if (*lambdaFunction.getLambdaInfo().ParamsType != leftVal.getDetailTypeHold())
-				return RuntimeError<RuntimeTypeError>(
-					std::format(
-						"Parameters type must be equal to argument type. ({} != {})",
-						*lambdaFunction.getLambdaInfo().ParamsType,
-						leftVal.getDetailTypeHold()
-					)
-				);
-
 			Result<RuntimeTypedExprComponent, std::runtime_error>&& prefixOperatorResult{
-				lambdaFunction.evaluate(EvaluatorLambdaFunctions, std::move(leftVal))
+				_applyPrefix(
+					EvaluatorLambdaFunctions.at(currNode->value()),
+					resultMap[currNode->leftPos].value(),
+					EvaluatorLambdaFunctions
+				)
 			};
 
 			if (prefixOperatorResult.isError())
-				return RuntimeError<LambdaEvaluationError>(
-					prefixOperatorResult.getException(),
-					std::format(
-						"When attempting to evaluate the prefix lambda function. (left nodeExpression value = {})",
-						resultMap[currNode->leftPos].value()
-					),
-					"Lambda::_NodeExpressionEvaluate"
-				);
+				return prefixOperatorResult.getException();
+
+			currNode.emplace(NodeFactory::node(currNodePos)); // evaluate can move the node columns.
 
+			resultMap.erase(currNode->leftPos);
 			resultMap[currNodePos] = prefixOperatorResult.moveValue();
 		}
 
@@ -19,7 +19,7 @@ inline NodePointer::NodePointer() :
 	)
 {}
 
-inline bool NodePointer::isTypeValid(const std::unordered_map<std::string, Lambda>& EvaluatorLambdaFunction) const {
+inline bool NodePointer::isTypeValid(const EvaluatorScope& EvaluatorLambdaFunction) const {
 	if (Result<RuntimeType, std::runtime_error> targetType{ getReturnType(mNodeExpression, EvaluatorLambdaFunction) }; targetType.isError())
 		return false;
 	return true;
@@ -29,7 +29,13 @@ inline bool NodePointer::isNodePointerValid() const {
 	return NodeFactory::validNode(mNodeExpression);
 }
 
-inline Result<RuntimeTypedExprComponent, std::runtime_error> NodePointer::getPointed(const std::unordered_map<std::string, Lambda>& EvaluatorLambdaFunction) const {
+inline Result<RuntimeTypedExprComponent, std::runtime_error> NodePointer::getPointed(const EvaluatorScope& EvaluatorLambdaFunction) const {
+	if (mNodeExpression != NodeFactory::NodePosNull && !NodeFactory::validNode(mNodeExpression))
+		return RuntimeError<RuntimeTypeError>(
+			std::format("The NodePointer \"{}\" is stale, the pointed node was released.", mNodeExpression),
+			"NodePointer::getPointed"
+		);
+
 	return RuntimeTypedExprComponent::fromNodeExpression(mNodeExpression, EvaluatorLambdaFunction);
 }
 
@@ -37,7 +43,7 @@ inline NodeFactory::NodePos NodePointer::getPointerIndex() const {
 	return mNodeExpression;
 }
 
-inline const NodeFactory::Node& NodePointer::getPointerNode() const {
+inline NodeFactory::Node NodePointer::getPointerNode() const {
 	return NodeFactory::node(mNodeExpression);
 }
 
@@ -2,6 +2,7 @@
 #define RUNTIME_TYPED_EXPR_COMPONENT_IMPL_NUMBER
 
 #include "runtimeTypedExprComponent.h"
+#include "numberText.h"
 
 inline Number::Number(long double number) :
 	BaseRuntimeTypedExprComponent{
@@ -34,14 +35,14 @@ inline Number::Number(NodePos numberExpression, bool) :
 		RuntimeBaseType::Number,
 		numberExpression
 },
-mNumber{ std::stold(NodeFactory::node(numberExpression).value) } {}
+mNumber{ NodeFactory::node(numberExpression).isNumber() ? NodeFactory::node(numberExpression).number() : parseNumberPrefix(NodeFactory::node(numberExpression).value()) } {}
 
 inline NodeFactory::NodePos Number::generateExpressionTree() const {
-	return NodeFactory::create(std::to_string(mNumber));
+	return NodeFactory::createNumber(mNumber);
 }
 
 inline std::string Number::toString() const {
-	return std::to_string(mNumber);
+	return formatNumber(mNumber);
 }
 
 #endif //RUNTIME_TYPED_EXPR_COMPONENT_IMPL_NUMBER
\ No newline at end of file
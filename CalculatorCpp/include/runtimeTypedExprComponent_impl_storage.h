@@ -47,12 +47,13 @@ inline Storage& Storage::operator=(Storage&& other) noexcept {
 	return *this;
 }
 
-inline Result<Storage, std::runtime_error> Storage::fromVector(const RuntimeCompoundType& storageType, const StorageArguments& storageData) {
-	std::vector<RuntimeType> storageDataTypes;
-	storageDataTypes.reserve(storageData.size());
+inline RuntimeCompoundType Storage::iStorageTypeOf(const StorageArguments& storageData) {
+	// the element types are only read by the interning lookup, the buffer is reused so a known type allocates nothing.
+	thread_local std::vector<RuntimeType> storageDataTypes;
+	storageDataTypes.clear();
 
 	for (const auto& storageArg : storageData) {
-		std::visit([&storageDataTypes](const auto& arg) {
+		std::visit([](const auto& arg) {
 			using T = std::decay_t<decltype(arg)>;
 			if constexpr (std::is_same_v<T, Number> ||
 				std::is_same_v<T, Storage> ||
@@ -62,46 +63,23 @@ inline Result<Storage, std::runtime_error> Storage::fromVector(const RuntimeComp
 			}, storageArg);
 	}
 
-	if (RuntimeCompoundType::gurantreeNoRuntimeEvaluateStorage(std::move(storageDataTypes)) != storageType)
+	return RuntimeCompoundType::gurantreeNoRuntimeEvaluateStorage(storageDataTypes);
+}
+
+inline Result<Storage, std::runtime_error> Storage::fromVector(const RuntimeCompoundType& storageType, const StorageArguments& storageData) {
+	if (iStorageTypeOf(storageData) != storageType)
 		return std::runtime_error("Storage argument type and storage configured type not matched.");
 
 	return Storage(storageType, storageData);
 }
 
 inline Storage Storage::fromVector(const StorageArguments& storageData) {
-	std::vector<RuntimeType> storageDataTypes;
-	storageDataTypes.reserve(storageData.size());
-
-	for (const auto& storageArg : storageData) {
-		std::visit([&storageDataTypes](const auto& arg) {
-			using T = std::decay_t<decltype(arg)>;
-			if constexpr (std::is_same_v<T, Number> ||
-				std::is_same_v<T, Storage> ||
-				std::is_same_v<T, Lambda>) {
-				storageDataTypes.emplace_back(arg.getType());
-			}
-			}, storageArg);
-	}
-
-	return Storage(RuntimeCompoundType::gurantreeNoRuntimeEvaluateStorage(storageDataTypes), storageData);
+	return Storage(iStorageTypeOf(storageData), storageData);
 }
 
 inline Storage Storage::fromVector(StorageArguments&& storageData) {
-	std::vector<RuntimeType> storageDataTypes;
-	storageDataTypes.reserve(storageData.size());
-
-	for (const auto& storageArg : storageData) {
-		std::visit([&storageDataTypes](const auto& arg) {
-			using T = std::decay_t<decltype(arg)>;
-			if constexpr (std::is_same_v<T, Number> ||
-				std::is_same_v<T, Storage> ||
-				std::is_same_v<T, Lambda>) {
-				storageDataTypes.emplace_back(arg.getType());
-			}
-			}, storageArg);
-	}
-
-	return Storage(RuntimeCompoundType::gurantreeNoRuntimeEvaluateStorage(std::move(storageDataTypes)), std::move(storageData));
+	RuntimeCompoundType storageType{ iStorageTypeOf(storageData) };
+	return Storage(std::move(storageType), std::move(storageData));
 }
 
 inline Storage Storage::NullStorage() {
@@ -132,7 +110,7 @@ inline Storage Storage::fromArgs(Args &&...storageData) {
 	return Storage(RuntimeCompoundType::Storage(std::move(storageDataTypes)), std::move(tmp));
 }
 
-inline Result<Storage, std::runtime_error> Storage::fromExpressionNode(NodePos storageRootNode, const std::unordered_map<std::string, Lambda>& EvaluatorLambdaFunctions) {
+inline Result<Storage, std::runtime_error> Storage::fromExpressionNode(NodePos storageRootNode, const EvaluatorScope& EvaluatorLambdaFunctions) {
 	if (!NodeFactory::validNode(storageRootNode) || NodeFactory::node(storageRootNode).nodestate != NodeFactory::Node::NodeState::Storage)
 		return std::runtime_error("storageRootNode must be valid node with Storage nodestate.");
 
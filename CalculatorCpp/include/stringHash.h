@@ -0,0 +1,30 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <functional>
+#include <unordered_map>
+#include <unordered_set>
+#include <stdexcept>
+
+// hash for std::string keyed containers that can be searched with a std::string_view without building a key.
+struct StringHash {
+	using is_transparent = void;
+
+	size_t operator()(std::string_view text) const {
+		return std::hash<std::string_view>{}(text);
+	}
+};
+
+template <typename Value>
+using StringMap = std::unordered_map<std::string, Value, StringHash, std::equal_to<>>;
+using StringSet = std::unordered_set<std::string, StringHash, std::equal_to<>>;
+
+// at() of a StringMap, which has no std::string_view overload.
+template <typename Value>
+const Value& stringMapAt(const StringMap<Value>& map, std::string_view key) {
+	const auto valueIt{ map.find(key) };
+	if (valueIt == map.end())
+		throw std::out_of_range("stringMapAt, key not found.");
+	return valueIt->second;
+}
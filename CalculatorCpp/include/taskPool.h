@@ -0,0 +1,95 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fork-join pool for work that touches no nodes (a NodeFactory belongs to one thread).
+// Every worker owns a deque, it takes its own tasks from the back and steals the oldest ones of the others from the front.
+// Tasks spawned outside of the pool go to a shared deque. Joining a task runs it on the joining thread unless another
+// thread took it first, meanwhile the joining thread runs other pending tasks instead of blocking.
+class TaskPool {
+public:
+	class Task {
+	public:
+		explicit Task(std::function<void()> work);
+
+	private:
+		enum State : uint8_t {
+			Pending,
+			Running,
+			Done,
+		};
+
+		std::function<void()> mWork;
+		std::atomic<uint8_t> mState{ Pending };
+		std::exception_ptr mException;
+
+		bool iClaim();
+		void iRun();
+		friend class TaskPool;
+	};
+
+	// tasks spawned by one caller. The ones not joined when the group is destroyed (the caller left early, e.g. through
+	// an exception) are discarded, so no task outlives the caller's state it refers to.
+	class Group {
+	public:
+		explicit Group(TaskPool& pool);
+		~Group();
+		Group(const Group& other) = delete;
+		Group& operator=(const Group& other) = delete;
+
+		// the task lives as long as the group.
+		Task& spawn(std::function<void()> work);
+		void join(Task& task);
+
+	private:
+		TaskPool& mPool;
+		std::vector<std::shared_ptr<Task>> mTasks;
+	};
+
+	static TaskPool& instance();
+
+	// hardware_concurrency() - 1 workers unless changed, with none every task runs on the thread joining it.
+	// Changing the amount waits for the current workers, no task may be pending meanwhile.
+	size_t workerAmount() const;
+	void setWorkerAmount(size_t workerAmount);
+
+	void spawn(std::shared_ptr<Task> task);
+	// the task is done when join returns, an exception it threw is rethrown here.
+	void join(Task& task);
+	// a task that didn't start is dropped, returns once the task doesn't run anymore.
+	void discard(Task& task);
+
+	TaskPool(const TaskPool& other) = delete;
+	TaskPool& operator=(const TaskPool& other) = delete;
+	~TaskPool();
+
+private:
+	struct Queue {
+		std::mutex mutex;
+		std::deque<std::shared_ptr<Task>> tasks;
+	};
+
+	std::vector<std::unique_ptr<Queue>> mQueues; // the shared queue, then one per worker.
+	std::vector<std::jthread> mWorkers;
+	std::atomic<size_t> mPendingTasks{ 0 };
+	std::mutex mSleepMutex;
+	std::condition_variable mWakeUp;
+	bool mStop{ false };
+
+	inline static thread_local size_t mLocalQueue{ 0 }; // index of the calling worker's queue, 0 on any other thread.
+
+	TaskPool();
+	void iStartWorkers(size_t workerAmount);
+	void iStopWorkers();
+	void iWorkerLoop(size_t queueIndex);
+	std::shared_ptr<Task> iFindTask();
+};
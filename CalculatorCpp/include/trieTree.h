@@ -1,47 +1,85 @@
 #pragma once
-#include <unordered_map>
 #include <unordered_set>
 #include <string>
+#include <string_view>
 #include <vector>
-#include <memory>
+#include <array>
+#include <span>
+#include <cstdint>
 
+// keywords a scope adds on top of a TrieTree, matched next to the tree instead of being inserted into it.
+// Words is sorted and isn't owned, the overlays of the enclosing scopes are chained through Parent,
+// so opening or closing a scope changes no tree and allocates nothing.
+struct KeywordOverlay {
+    std::span<const std::string_view> Words;
+    const KeywordOverlay* Parent{ nullptr };
+
+    bool contains(std::string_view word) const;
+    bool startsWith(std::string_view prefix) const;
+};
+
+// Keyword automaton stored as one flat transition table: a row per trie state, a column per byte class
+// (bytes used by no keyword share class 0, whose column is always the dead state).
+// Matching a character is two array reads, there are no per-node allocations to chase.
 class TrieTree {
 public:
-    class TrieNode {
-    public:
-        bool isEndOfWord = false;
-        std::unordered_map<char, std::unique_ptr<TrieNode>> children;
-    };
+    using State = uint32_t;
 
 private:
-    std::unique_ptr<TrieNode> root = std::make_unique<TrieNode>();
+    static constexpr State DeadState = 0;
+    static constexpr State RootState = 1;
+
+    std::array<uint16_t, 256> mByteClass{};
+    size_t mClassCount{ 1 };
+    std::vector<State> mTransitions;
+    std::vector<uint8_t> mEndOfWord;
+    size_t mUnreachableStates{ 0 };
     std::unordered_set<std::string> validWords;
 
-public:
-    TrieTree() = default;
-    TrieTree(const std::vector<std::string>& mainKeywords) {
-        for (const std::string& keyword : mainKeywords)
-            insert(keyword);
+    State iNextState(State state, char chr) const {
+        return mTransitions[state * mClassCount + mByteClass[static_cast<unsigned char>(chr)]];
     }
+    State iAddState();
+    void iAddClass(unsigned char chr);
+    void iInsertPath(const std::string& word);
+    void iRebuild();
+
+public:
+    TrieTree();
+    TrieTree(const std::vector<std::string>& mainKeywords);
 
     void insert(const std::string& word);
 
-    bool search(const std::string& word) const;
+    bool search(std::string_view word) const;
+
+    bool startsWith(std::string_view prefix) const;
 
-    bool startsWith(const std::string& prefix) const;
-    
     bool remove(const std::string& word);
 
     class StartsWithsInstance {
     private:
-        TrieNode * mRootNode;
-        TrieNode* mCurrentTrieNode;
+        // the words of one overlay that start with the characters inserted so far, they lie next to each other.
+        struct WordRange {
+            size_t First;
+            size_t Last;
+        };
+
+        const TrieTree* mTrieTree;
+        const KeywordOverlay* mOverlay;
+        State mCurrentState; // DeadState while only overlay words match
+        size_t mInsertedCount{ 0 };
+        std::vector<WordRange> mOverlayRanges; // one per overlay in the chain, innermost first
         bool mResult{ false };
+
+        bool iOverlayAccepts(char currChar) const;
+        void iNarrowOverlay(char currChar);
     public:
-        explicit StartsWithsInstance(const TrieTree &trieTree);
+        explicit StartsWithsInstance(const TrieTree &trieTree, const KeywordOverlay* overlay = nullptr);
         bool insertChar(const char currChar);
         bool previewInsertChar(const char currChar);
         bool getResult() const;
         void reset();
+        // nothing was inserted since the last reset.
+        bool isReset() const;
     };
 };
@@ -0,0 +1,110 @@
+#include "byteScanner.h"
+#include <bit>
+#include <cstdint>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define BYTE_SCANNER_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define BYTE_SCANNER_SSE2
+#endif
+
+void ByteScanner::insert(char byte) {
+	if (contains(byte))
+		return;
+
+	mTable[static_cast<unsigned char>(byte)] = true;
+	if (mByteCount < MaxVectorBytes)
+		mBytes[mByteCount++] = byte;
+	else
+		mVectorizable = false;
+}
+
+void ByteScanner::insertRange(char first, char last) {
+	// the range compare is signed, so only a range that stays inside ASCII (and leaves room for last + 1) fits it.
+	if (mHasRange || first <= 0 || first > last || last >= 127) {
+		for (int byte{ first }; byte <= last; byte++)
+			insert(static_cast<char>(byte));
+		return;
+	}
+
+	mHasRange = true;
+	mRangeFirst = first;
+	mRangeLast = last;
+	for (int byte{ first }; byte <= last; byte++)
+		mTable[static_cast<unsigned char>(byte)] = true;
+}
+
+template <bool Matching>
+size_t ByteScanner::iFind(std::string_view content, size_t from) const {
+	const char* data{ content.data() };
+	const size_t size{ content.size() };
+
+	// most runs are a byte or two long, those are settled before any vector is set up.
+	if (from >= size || contains(data[from]) == Matching)
+		return from < size ? from : size;
+	from++;
+
+#if defined(BYTE_SCANNER_AVX2)
+	if (mVectorizable) {
+		__m256i needles[MaxVectorBytes];
+		for (size_t ind{ 0 }; ind < mByteCount; ind++)
+			needles[ind] = _mm256_set1_epi8(mBytes[ind]);
+		const __m256i rangeBelow{ _mm256_set1_epi8(static_cast<char>(mRangeFirst - 1)) };
+		const __m256i rangeAbove{ _mm256_set1_epi8(static_cast<char>(mRangeLast + 1)) };
+
+		for (; from + 32 <= size; from += 32) {
+			const __m256i block{ _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + from)) };
+			__m256i matches{ _mm256_setzero_si256() };
+			for (size_t ind{ 0 }; ind < mByteCount; ind++)
+				matches = _mm256_or_si256(matches, _mm256_cmpeq_epi8(block, needles[ind]));
+			if (mHasRange)
+				matches = _mm256_or_si256(matches, _mm256_and_si256(_mm256_cmpgt_epi8(block, rangeBelow), _mm256_cmpgt_epi8(rangeAbove, block)));
+
+			uint32_t mask{ static_cast<uint32_t>(_mm256_movemask_epi8(matches)) };
+			if constexpr (!Matching)
+				mask = ~mask;
+			if (mask)
+				return from + std::countr_zero(mask);
+		}
+	}
+#elif defined(BYTE_SCANNER_SSE2)
+	if (mVectorizable) {
+		__m128i needles[MaxVectorBytes];
+		for (size_t ind{ 0 }; ind < mByteCount; ind++)
+			needles[ind] = _mm_set1_epi8(mBytes[ind]);
+		const __m128i rangeBelow{ _mm_set1_epi8(static_cast<char>(mRangeFirst - 1)) };
+		const __m128i rangeAbove{ _mm_set1_epi8(static_cast<char>(mRangeLast + 1)) };
+
+		for (; from + 16 <= size; from += 16) {
+			const __m128i block{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + from)) };
+			__m128i matches{ _mm_setzero_si128() };
+			for (size_t ind{ 0 }; ind < mByteCount; ind++)
+				matches = _mm_or_si128(matches, _mm_cmpeq_epi8(block, needles[ind]));
+			if (mHasRange)
+				matches = _mm_or_si128(matches, _mm_and_si128(_mm_cmpgt_epi8(block, rangeBelow), _mm_cmplt_epi8(block, rangeAbove)));
+
+			uint32_t mask{ static_cast<uint32_t>(_mm_movemask_epi8(matches)) };
+			if constexpr (!Matching)
+				mask = ~mask & 0xFFFF;
+			if (mask)
+				return from + std::countr_zero(mask);
+		}
+	}
+#endif
+
+	for (; from < size; from++) {
+		if (contains(data[from]) == Matching)
+			return from;
+	}
+	return size;
+}
+
+size_t ByteScanner::findFirstOf(std::string_view content, size_t from) const {
+	return iFind<true>(content, from);
+}
+
+size_t ByteScanner::findFirstNotOf(std::string_view content, size_t from) const {
+	return iFind<false>(content, from);
+}
@@ -3,7 +3,6 @@
 #include <unordered_set>
 #include <string>
 #include <tuple>
-#include <queue>
 #include "initialization.h"
 #include "nodeFactory.h"
 
@@ -65,42 +64,15 @@ void initializeLexer(Lexer& lexer) {
 	lexer.setSeperatorKeys(mainSeparatorKeys);
 }
 
-std::function<std::vector<std::string>(const std::string&)> initializeStaticLexer(const std::vector<std::string>& extendsKeywords) {
-	static TrieTree keywordTree(mainKeywords);
-	static TrieTree rawStringBracketKeywordTree(mainRawStringBracket);
-	static Brackets rawStringBracket{ splitIntoPairs(mainRawStringBracket) };
-	static std::queue<std::string> skeduleRemove;
+StaticLexer initializeStaticLexer(const KeywordOverlay* extendsKeywords) {
+	// never modified, the extending keywords are matched next to them, so every thread shares the same trees.
+	static const TrieTree keywordTree(mainKeywords);
+	static const TrieTree rawStringBracketKeywordTree(mainRawStringBracket);
+	static const Brackets rawStringBracket{ splitIntoPairs(mainRawStringBracket) };
 
-	while (!skeduleRemove.empty()) {
-		keywordTree.remove(skeduleRemove.front());
-		skeduleRemove.pop();
-	}
-
-	for (const std::string& extendsKeyword : extendsKeywords) {
-		keywordTree.insert(extendsKeyword);
-		skeduleRemove.emplace(extendsKeyword);
-	}
-
-	return [](const std::string& content) {return Lexer::lexing(keywordTree, rawStringBracketKeywordTree, mainSeparatorKeys, rawStringBracket, content); };
-}
-
-std::function<std::vector<std::string>(const std::string&)> initializeStaticLexer(const std::unordered_set<std::string>& extendsKeywords) {
-	static TrieTree keywordTree(mainKeywords);
-	static TrieTree rawStringBracketKeywordTree(mainRawStringBracket);
-	static Brackets rawStringBracket{ splitIntoPairs(mainRawStringBracket) };
-	static std::queue<std::string> skeduleRemove;
-
-	while (!skeduleRemove.empty()) {
-		keywordTree.remove(skeduleRemove.front());
-		skeduleRemove.pop();
-	}
-
-	for (const std::string& extendsKeyword : extendsKeywords) {
-		keywordTree.insert(extendsKeyword);
-		skeduleRemove.emplace(extendsKeyword);
-	}
-
-	return [](const std::string& content) {return Lexer::lexing(keywordTree, rawStringBracketKeywordTree, mainSeparatorKeys, rawStringBracket, content); };
+	return [extendsKeywords](std::string_view content, size_t from, std::span<const RawStringSpan> knownRawStrings, std::vector<RawStringSpan>* foundRawStrings) {
+		return Lexer::tokenize(keywordTree, extendsKeywords, rawStringBracketKeywordTree, mainSeparatorKeys, rawStringBracket, content, from, knownRawStrings, foundRawStrings);
+		};
 }
 
 void initializeParser(Parser& parser) {
@@ -4,15 +4,17 @@
 #include <iterator>
 #include <cctype>
 #include <stack>
+#include <array>
+#include <algorithm>
 
 #include "runtime_error.h"
 
 #define DEBUG
 #include "debug.cpp"
 
-static void nonEmptyPushback(std::vector<std::string>& vec, const std::string& str)
-{
-	if (!str.empty()) vec.emplace_back(str);
+static const std::string* findBracket(const StringMap<std::string>& brackets, std::string_view bracket) {
+	const auto bracketIt{ brackets.find(bracket) };
+	return (bracketIt != brackets.end()) ? &bracketIt->second : nullptr;
 }
 
 void Lexer::setKeywords(const std::vector<std::string>& keywords)
@@ -63,144 +65,370 @@ const TrieTree& Lexer::getKeywordTree() const {
 	return mKeywordTree;
 }
 
-bool handleRawString(
-	char chr,
-	std::vector<std::string>& temp,
-	std::string& buff,
-	std::string& rawStringBracketBuff,
-	TrieTree::StartsWithsInstance& startWithInst,
-	TrieTree::StartsWithsInstance& startWithRawStringInst,
-	std::stack<std::string>& isCurrentRawString,
-	const Brackets& rawStringBracket) {
-	if (!buff.empty() && isCurrentRawString.empty()) {
-		isCurrentRawString.emplace(temp.back());
-		startWithRawStringInst.reset();
-		startWithInst.reset();
-
-		if (startWithRawStringInst.insertChar(buff.back())) {
-			rawStringBracketBuff += buff.back();
-			buff.pop_back();
+// first bytes of every raw string bracket, a raw string can't end or nest before one of them.
+static ByteScanner bracketStartScanner(const Brackets& rawStringBracket) {
+	ByteScanner bracketStarts;
+	for (const auto& [openBracket, closeBracket] : rawStringBracket.openBracketsOperators) {
+		if (!openBracket.empty())
+			bracketStarts.insert(openBracket.front());
+		if (!closeBracket.empty())
+			bracketStarts.insert(closeBracket.front());
+	}
+	for (const auto& [closeBracket, _] : rawStringBracket.closeBracketsOperators) {
+		if (!closeBracket.empty())
+			bracketStarts.insert(closeBracket.front());
+	}
+	return bracketStarts;
+}
+
+TokenStream::TokenStream(
+	const TrieTree& keywordTree,
+	const KeywordOverlay* keywordOverlay,
+	const TrieTree& rawStringBracketTree,
+	const std::unordered_set<char>& separatorKeys,
+	const Brackets& rawStringBracket,
+	bool collectUnvalidPositions) :
+	mKeywordTree{ &keywordTree },
+	mKeywordOverlay{ keywordOverlay },
+	mRawStringBracket{ &rawStringBracket },
+	mBracketStarts{ bracketStartScanner(rawStringBracket) },
+	mStartWithInst{ keywordTree, keywordOverlay },
+	mStartWithRawStringInst{ rawStringBracketTree },
+	mCollectUnvalidPositions{ collectUnvalidPositions } {
+	for (char separatorKey : separatorKeys)
+		mSeparators.insert(separatorKey);
+
+	// runs of digits and of separators are skipped in bulk, unless one of their bytes could start a keyword.
+	auto startsKeyword = [&keywordTree, keywordOverlay](char chr) {
+		const std::string_view prefix(&chr, 1);
+		return keywordTree.startsWith(prefix) || (keywordOverlay && keywordOverlay->startsWith(prefix));
+		};
+	mSkipDigitRuns = std::ranges::none_of(std::string_view("0123456789"), startsKeyword);
+	mSkipSeparatorRuns = std::ranges::none_of(separatorKeys, startsKeyword) && !iIsKeyword("");
+}
+
+bool TokenStream::iIsKeyword(std::string_view text) const {
+	return mKeywordTree->search(text) || (mKeywordOverlay && mKeywordOverlay->contains(text));
+}
+
+void TokenStream::iEmit(std::string_view content, const LexemeSpan& span, Token::Kind kind, std::vector<Token>& tokens) {
+	tokens.emplace_back(Token{ mContentOffset + span.Offset, span.Length, kind });
+
+	const auto openBracketIt{ mRawStringBracket->openBracketsOperators.find(span.text(content)) };
+	mLastOpenBracket = (openBracketIt != mRawStringBracket->openBracketsOperators.end()) ? &*openBracketIt : nullptr;
+	mHasTokens = true;
+}
+
+void TokenStream::iClearBuffer(std::string_view content, std::vector<Token>& tokens) {
+	if (iIsKeyword(mBuff.text(content)))
+		iEmit(content, mBuff, Token::Kind::Keyword, tokens);
+	mStartWithInst.reset();
+	mBuff.clear();
+}
+
+const RawStringSpan* TokenStream::iKnownRawString(std::string_view content, size_t offset) {
+	// raw strings open in the order they are listed, the ones before offset were passed already.
+	while (mNextKnownRawString < mKnownRawStrings.size() && mKnownRawStrings[mNextKnownRawString].Offset < offset)
+		mNextKnownRawString += mKnownRawStrings[mNextKnownRawString].NestedCount + 1;
+	if (mNextKnownRawString >= mKnownRawStrings.size())
+		return nullptr;
+
+	const RawStringSpan& known{ mKnownRawStrings[mNextKnownRawString] };
+	if (known.Offset != offset || known.Length == RawStringSpan::Unclosed || !known.Length ||
+		offset + known.Length >= content.size() || !content.substr(offset + known.Length).starts_with(mLastOpenBracket->second))
+		return nullptr;
+	return &known;
+}
+
+void TokenStream::iOpenRawString(size_t offset) {
+	if (!mFoundRawStrings)
+		return;
+	// absolute until it closes, then relative to its parent.
+	mOpenRawStrings.push_back(mFoundRawStrings->size());
+	mFoundRawStrings->emplace_back(RawStringSpan{ mContentOffset + offset, RawStringSpan::Unclosed, 0 });
+}
+
+void TokenStream::iCloseRawString(size_t closeOffset, bool matched) {
+	if (!mFoundRawStrings || mOpenRawStrings.empty())
+		return;
+
+	const size_t index{ mOpenRawStrings.back() };
+	mOpenRawStrings.pop_back();
+	RawStringSpan& rawString{ (*mFoundRawStrings)[index] };
+
+	if (closeOffset == RawStringSpan::Unclosed || mContentOffset + closeOffset < rawString.Offset) {
+		matched = false;
+		rawString.Length = RawStringSpan::Unclosed;
+	}
+	else
+		rawString.Length = mContentOffset + closeOffset - rawString.Offset;
+	rawString.NestedCount = mFoundRawStrings->size() - index - 1;
+	rawString.Offset -= mOpenRawStrings.empty() ? 0 : (*mFoundRawStrings)[mOpenRawStrings.back()].Offset;
+
+	// the same text can end up nested differently when lexed on its own, so none of it is listed.
+	mMismatchedRawString |= !matched;
+	if (mOpenRawStrings.empty() && mMismatchedRawString) {
+		mFoundRawStrings->resize(index + 1);
+		rawString.NestedCount = 0;
+		mMismatchedRawString = false;
+	}
+}
+
+bool TokenStream::iHandleRawString(std::string_view content, size_t& ind, std::vector<Token>& tokens) {
+	char chr{ content[ind] };
+
+	if (!mBuff.empty() && mCurrentRawStrings.empty()) {
+		mCurrentRawStrings.emplace(mLastOpenBracket->first);
+		mStartWithRawStringInst.reset();
+		mStartWithInst.reset();
+
+		// a raw string lexed before, its content (nested raw strings and all) goes into the buffer at once.
+		if (const RawStringSpan* known{ iKnownRawString(content, mBuff.Offset) }) {
+			mBuff.Length = known->Length;
+			ind = mBuff.Offset + known->Length;
+			chr = content[ind];
+		}
+		else {
+			iOpenRawString(mBuff.Offset);
+			if (mStartWithRawStringInst.insertChar(content[mBuff.back()])) {
+				mRawStringBracketBuff.push(mBuff.back());
+				mBuff.Length--;
+			}
 		}
 	}
 
-	if (startWithRawStringInst.insertChar(chr)) {
-		rawStringBracketBuff += chr;
+	if (mStartWithRawStringInst.insertChar(chr)) {
+		mRawStringBracketBuff.push(ind);
 		return true;
 	}
 
-	else if (!rawStringBracketBuff.empty() &&
-		rawStringBracket.openBracketsOperators.contains(temp.back()) &&
-		rawStringBracket.openBracketsOperators.at(temp.back()) == rawStringBracketBuff)
+	else if (const std::string* closeBracket{ (mRawStringBracketBuff.empty() || !mLastOpenBracket) ? nullptr : &mLastOpenBracket->second };
+		closeBracket && *closeBracket == mRawStringBracketBuff.text(content))
 	{
-		isCurrentRawString.pop();
-		if (isCurrentRawString.empty()) {
-			nonEmptyPushback(temp, buff);
-			nonEmptyPushback(temp, rawStringBracketBuff);
-			buff.clear();
-			rawStringBracketBuff.clear();
+		const std::string* topCloseBracket{ mCurrentRawStrings.empty() ? nullptr : findBracket(mRawStringBracket->openBracketsOperators, mCurrentRawStrings.top()) };
+		iCloseRawString(mRawStringBracketBuff.Offset, topCloseBracket && *topCloseBracket == *closeBracket);
+
+		mCurrentRawStrings.pop();
+		if (mCurrentRawStrings.empty()) {
+			if (!mBuff.empty())
+				iEmit(content, mBuff, Token::Kind::RawExpression, tokens);
+			if (!mRawStringBracketBuff.empty())
+				iEmit(content, mRawStringBracketBuff, Token::Kind::Keyword, tokens);
+			mBuff.clear();
+			mRawStringBracketBuff.clear();
 		}
 		else {
-			buff += rawStringBracketBuff;
+			mBuff.append(mRawStringBracketBuff);
 
-			startWithRawStringInst.reset();
-			rawStringBracketBuff.clear();
+			mStartWithRawStringInst.reset();
+			mRawStringBracketBuff.clear();
 
-			if (startWithRawStringInst.insertChar(chr))
-				rawStringBracketBuff += chr;
+			if (mStartWithRawStringInst.insertChar(chr))
+				mRawStringBracketBuff.push(ind);
 			else
-				buff += chr;
+				mBuff.push(ind);
 			return true;
 		}
 	}
 
 	else
 	{
-		if (rawStringBracket.openBracketsOperators.contains(rawStringBracketBuff))
-			isCurrentRawString.emplace(rawStringBracketBuff);
-
-		if (!isCurrentRawString.empty() && rawStringBracket.closeBracketsOperators.contains(rawStringBracketBuff) &&
-			rawStringBracket.closeBracketsOperators.at(rawStringBracketBuff) == isCurrentRawString.top())
-			isCurrentRawString.pop();
-
-		buff += rawStringBracketBuff;
+		// most characters of a raw string are no bracket at all, the lookups are only needed for one.
+		if (!mRawStringBracketBuff.empty()) {
+			const std::string_view bracket{ mRawStringBracketBuff.text(content) };
+			if (const auto openBracketIt{ mRawStringBracket->openBracketsOperators.find(bracket) }; openBracketIt != mRawStringBracket->openBracketsOperators.end()) {
+				mCurrentRawStrings.emplace(openBracketIt->first);
+				iOpenRawString(mRawStringBracketBuff.Offset + mRawStringBracketBuff.Length);
+			}
+
+			if (const std::string* openBracket{ findBracket(mRawStringBracket->closeBracketsOperators, bracket) };
+				!mCurrentRawStrings.empty() && openBracket && *openBracket == mCurrentRawStrings.top()) {
+				iCloseRawString(mRawStringBracketBuff.Offset, true);
+				mCurrentRawStrings.pop();
+			}
+
+			mBuff.append(mRawStringBracketBuff);
+		}
 
-		startWithRawStringInst.reset();
-		rawStringBracketBuff.clear();
+		mStartWithRawStringInst.reset();
+		mRawStringBracketBuff.clear();
 
-		if (startWithRawStringInst.insertChar(chr))
-			rawStringBracketBuff += chr;
-		else
-			buff += chr;
+		if (mStartWithRawStringInst.insertChar(chr))
+			mRawStringBracketBuff.push(ind);
+		else {
+			mBuff.push(ind);
+
+			// inside the raw string, every byte up to the next bracket would only be appended too.
+			if (!mCurrentRawStrings.empty()) {
+				const size_t runEnd{ mBracketStarts.findFirstOf(content, ind + 1) };
+				mBuff.Length += runEnd - ind - 1;
+				ind = runEnd - 1;
+			}
+		}
 		return true;
 	}
 
 	return false;
 }
 
-Result<std::vector<std::string>, std::runtime_error> Lexer::lexing(const std::string& currContent, bool throwError) const {
-	std::string buff;
-	std::string rawStringBracketBuff;
-	std::vector<std::string> temp;
-	std::vector<size_t> unvalidPosition;
-	TrieTree::StartsWithsInstance startWithInst(mKeywordTree);
-	TrieTree::StartsWithsInstance startWithRawStringInst(mRawStringBracketTree);
-
-	std::stack<std::string> isCurrentRawString;
-
-	buff.reserve(currContent.size());
-	temp.reserve(currContent.size());
-	unvalidPosition.reserve(currContent.size());
-
-	auto clearBuffer = [&buff, &temp, &startWithInst, this]() {
-		if (mKeywordTree.search(buff))
-			temp.emplace_back(buff);
-		startWithInst.reset();
-		buff.clear();
+void TokenStream::iLex(std::string_view content, size_t from, std::vector<Token>& tokens) {
+	static const ByteScanner digits{ [] {
+		ByteScanner digitScanner;
+		digitScanner.insertRange('0', '9');
+		return digitScanner;
+		}() };
+
+	auto isNumberBuffer = [this, content]() {
+		return !mBuff.empty() && std::isdigit(content[mBuff.Offset]);
 		};
 
-	for (size_t ind{ 0 }; ind < currContent.length(); ind++) {
-		char chr{ currContent[ind] };
+	for (size_t ind{ from }; ind < content.length(); ind++) {
+		const char chr{ content[ind] };
 
-		if ((!temp.empty() &&
-			(mRawStringBracket.openBracketsOperators.contains(temp.back()) || !isCurrentRawString.empty())) &&
-			handleRawString(chr, temp, buff, rawStringBracketBuff, startWithInst, startWithRawStringInst, isCurrentRawString, mRawStringBracket))
+		if (iInRawString() && iHandleRawString(content, ind, tokens))
 			continue;
 
-		if (std::isdigit(chr) && !startWithInst.previewInsertChar(chr)) {
-			if (!buff.empty() && !std::isdigit(buff.at(0)))
-				clearBuffer();
-			buff += chr;
+		if (std::isdigit(chr) && !mStartWithInst.previewInsertChar(chr)) {
+			if (!mBuff.empty() && !isNumberBuffer())
+				iClearBuffer(content, tokens);
+			mBuff.push(ind);
+
+			if (mSkipDigitRuns && mStartWithInst.isReset() && !iInRawString()) {
+				const size_t runEnd{ digits.findFirstNotOf(content, ind + 1) };
+				mBuff.Length += runEnd - ind - 1;
+				ind = runEnd - 1;
+			}
 			continue;
 		}
 
-		if (!buff.empty() && std::isdigit(buff.at(0))) {
-			temp.emplace_back(buff);
-			buff.clear();
+		if (isNumberBuffer()) {
+			iEmit(content, mBuff, Token::Kind::Number, tokens);
+			mBuff.clear();
 		}
 
-		if (mSeparatorKeys.contains(chr) || !startWithInst.insertChar(chr)) {
-			clearBuffer();
-			if (startWithInst.insertChar(chr) ||
-				(!temp.empty() && mRawStringBracket.openBracketsOperators.contains(temp.back())))
-				buff += chr;
-			else if (!mSeparatorKeys.contains(chr))
-				unvalidPosition.emplace_back(ind);
+		if (mSeparators.contains(chr) || !mStartWithInst.insertChar(chr)) {
+			iClearBuffer(content, tokens);
+			if (mStartWithInst.insertChar(chr) || mLastOpenBracket)
+				mBuff.push(ind);
+			else if (!mSeparators.contains(chr)) {
+				if (mCollectUnvalidPositions)
+					mUnvalidPositions.emplace_back(mContentOffset + ind);
+			}
+			// the following separators would only clear the already empty buffer again.
+			else if (mSkipSeparatorRuns && !iInRawString())
+				ind = mSeparators.findFirstNotOf(content, ind + 1) - 1;
 			continue;
 		}
-		buff += chr;
+		mBuff.push(ind);
 	}
+}
 
-	if (!isCurrentRawString.empty() && mRawStringBracket.closeBracketsOperators.contains(rawStringBracketBuff))
+void TokenStream::iFinish(std::string_view content, std::vector<Token>& tokens) {
+	if (!mCurrentRawStrings.empty() && mRawStringBracket->closeBracketsOperators.contains(mRawStringBracketBuff.text(content)))
 	{
-		nonEmptyPushback(temp, buff);
-		nonEmptyPushback(temp, rawStringBracketBuff);
+		while (mOpenRawStrings.size() > 1)
+			iCloseRawString(RawStringSpan::Unclosed, false);
+		iCloseRawString(mRawStringBracketBuff.Offset, true);
+
+		if (!mBuff.empty())
+			iEmit(content, mBuff, Token::Kind::RawExpression, tokens);
+		if (!mRawStringBracketBuff.empty())
+			iEmit(content, mRawStringBracketBuff, Token::Kind::Keyword, tokens);
+	}
+	else if (!mCurrentRawStrings.empty()) {
+		while (!mOpenRawStrings.empty())
+			iCloseRawString(RawStringSpan::Unclosed, false);
+
+		mBuff.append(mRawStringBracketBuff);
+		if (!mBuff.empty())
+			iEmit(content, mBuff, Token::Kind::RawExpression, tokens);
 	}
-	else if (!isCurrentRawString.empty())
-		nonEmptyPushback(temp, buff + rawStringBracketBuff);
 
-	else if (buff.length() && (mKeywordTree.search(buff) || std::isdigit(buff.at(0))))
-		temp.emplace_back(buff);
+	else if (!mBuff.empty() && std::isdigit(content[mBuff.Offset]))
+		iEmit(content, mBuff, Token::Kind::Number, tokens);
+	else if (!mBuff.empty() && iIsKeyword(mBuff.text(content)))
+		iEmit(content, mBuff, Token::Kind::Keyword, tokens);
+
+	mBuff.clear();
+	mRawStringBracketBuff.clear();
+}
 
+void TokenStream::feed(std::string_view chunk, std::vector<Token>& tokens) {
+	// the bytes before the lexeme in progress are lexed already, only that lexeme is carried over.
+	size_t carriedFrom{ mWindow.size() };
+	if (!mBuff.empty())
+		carriedFrom = std::min(carriedFrom, mBuff.Offset);
+	if (!mRawStringBracketBuff.empty())
+		carriedFrom = std::min(carriedFrom, mRawStringBracketBuff.Offset);
+
+	mWindow.erase(0, carriedFrom);
+	mContentOffset += carriedFrom;
+	// an empty span still has to be a position in the window.
+	mBuff.Offset = mBuff.empty() ? 0 : mBuff.Offset - carriedFrom;
+	mRawStringBracketBuff.Offset = mRawStringBracketBuff.empty() ? 0 : mRawStringBracketBuff.Offset - carriedFrom;
+
+	const size_t chunkBegin{ mWindow.size() };
+	mWindow += chunk;
+	iLex(mWindow, chunkBegin, tokens);
+}
+
+void TokenStream::finish(std::vector<Token>& tokens) {
+	iFinish(mWindow, tokens);
+}
+
+std::string_view TokenStream::text(const Token& token) const {
+	return std::string_view(mWindow).substr(token.Offset - mContentOffset, token.Length);
+}
+
+const std::vector<size_t>& TokenStream::unvalidPositions() const {
+	return mUnvalidPositions;
+}
+
+std::vector<Token> Lexer::tokenize(
+	const TrieTree& keywordTree,
+	const TrieTree& rawStringBracketTree,
+	const std::unordered_set<char>& separatorKeys,
+	const Brackets& rawStringBracket,
+	std::string_view currContent) {
+	return tokenize(keywordTree, nullptr, rawStringBracketTree, separatorKeys, rawStringBracket, currContent, 0, {}, nullptr);
+}
+
+std::vector<Token> Lexer::tokenize(
+	const TrieTree& keywordTree,
+	const KeywordOverlay* keywordOverlay,
+	const TrieTree& rawStringBracketTree,
+	const std::unordered_set<char>& separatorKeys,
+	const Brackets& rawStringBracket,
+	std::string_view currContent,
+	size_t from,
+	std::span<const RawStringSpan> knownRawStrings,
+	std::vector<RawStringSpan>* foundRawStrings) {
+	// the whole input is one chunk, lexed where it is instead of being copied into the stream.
+	TokenStream tokenStream(keywordTree, keywordOverlay, rawStringBracketTree, separatorKeys, rawStringBracket);
+	tokenStream.mKnownRawStrings = knownRawStrings;
+	if (knownRawStrings.empty())
+		tokenStream.mFoundRawStrings = foundRawStrings;
+
+	std::vector<Token> tokens;
+	tokens.reserve(currContent.size() - std::min(from, currContent.size()));
+	tokenStream.iLex(currContent, from, tokens);
+	tokenStream.iFinish(currContent, tokens);
+	return tokens;
+}
+
+TokenStream Lexer::tokenStream(bool collectUnvalidPositions) const {
+	return TokenStream(mKeywordTree, nullptr, mRawStringBracketTree, mSeparatorKeys, mRawStringBracket, collectUnvalidPositions);
+}
+
+Result<std::vector<Token>, std::runtime_error> Lexer::tokenize(std::string_view currContent, bool throwError, std::vector<RawStringSpan>* rawStrings) const {
+	TokenStream tokenStream(mKeywordTree, nullptr, mRawStringBracketTree, mSeparatorKeys, mRawStringBracket, throwError);
+	tokenStream.mFoundRawStrings = rawStrings;
+	std::vector<Token> tokens;
+	tokens.reserve(currContent.size());
+	tokenStream.iLex(currContent, 0, tokens);
+	tokenStream.iFinish(currContent, tokens);
+
+	const std::vector<size_t>& unvalidPosition{ tokenStream.unvalidPositions() };
 	if (throwError && unvalidPosition.size()) {
 		std::string errorMessage;
 		size_t unvalid_ind_ind{ 0 };
@@ -218,7 +446,21 @@ Result<std::vector<std::string>, std::runtime_error> Lexer::lexing(const std::st
 			"Lexer::lexing");
 	}
 	
-	return temp;
+	return tokens;
+}
+
+static std::vector<std::string> tokenTexts(const std::vector<Token>& tokens, std::string_view content) {
+	std::vector<std::string> texts;
+	texts.reserve(tokens.size());
+	for (const Token& token : tokens)
+		texts.emplace_back(token.text(content));
+	return texts;
+}
+
+Result<std::vector<std::string>, std::runtime_error> Lexer::lexing(const std::string& currContent, bool throwError) const {
+	Result<std::vector<Token>, std::runtime_error> tokens{ tokenize(currContent, throwError) };
+	EXCEPT_RETURN(tokens);
+	return tokenTexts(tokens.getValue(), currContent);
 }
 
 std::vector<std::string> Lexer::lexing(
@@ -227,64 +469,7 @@ std::vector<std::string> Lexer::lexing(
 	const std::unordered_set<char>& separatorKeys,
 	const Brackets& rawStringBracket,
 	const std::string& currContent) {
-	std::string buff{ "" };
-	std::string rawStringBracketBuff{ "" };
-	std::vector<std::string> temp;
-	TrieTree::StartsWithsInstance startWithInst(keywordTree);
-	TrieTree::StartsWithsInstance startWithRawStringInst(rawStringBracketTree);
-
-	std::stack<std::string> isCurrentRawString;
-
-	buff.reserve(50);
-	temp.reserve(50);
-
-	auto clearBuffer = [&buff, &temp, &startWithInst, &keywordTree]() {
-		if (keywordTree.search(buff))
-			temp.emplace_back(buff);
-		startWithInst.reset();
-		buff.clear();
-		};
-
-	for (char chr : currContent) {
-		if ((!temp.empty() &&
-			(rawStringBracket.openBracketsOperators.contains(temp.back()) || !isCurrentRawString.empty())) &&
-			handleRawString(chr, temp, buff, rawStringBracketBuff, startWithInst, startWithRawStringInst, isCurrentRawString, rawStringBracket))
-			continue;
-
-		if (std::isdigit(chr) && !startWithInst.previewInsertChar(chr)) {
-			if (!buff.empty() && !std::isdigit(buff.at(0)))
-				clearBuffer();
-			buff += chr;
-			continue;
-		}
-
-		if (!buff.empty() && std::isdigit(buff.at(0))) {
-			temp.emplace_back(buff);
-			buff.clear();
-		}
-
-		if (separatorKeys.contains(chr) || !startWithInst.insertChar(chr)) {
-			clearBuffer();
-			if (startWithInst.insertChar(chr) || (!temp.empty() && rawStringBracket.openBracketsOperators.contains(temp.back())))
-				buff += chr;
-			continue;
-		}
-
-		buff += chr;
-	}
-
-	if (!isCurrentRawString.empty() && rawStringBracket.closeBracketsOperators.contains(rawStringBracketBuff))
-	{
-		nonEmptyPushback(temp, buff);
-		nonEmptyPushback(temp, rawStringBracketBuff);
-	}
-	else if (!isCurrentRawString.empty())
-		nonEmptyPushback(temp, buff + rawStringBracketBuff);
-
-	else if (buff.length() && (keywordTree.search(buff) || (buff.length() && std::isdigit(buff.at(0)))))
-		temp.emplace_back(buff);
-
-	return temp;
+	return tokenTexts(tokenize(keywordTree, rawStringBracketTree, separatorKeys, rawStringBracket, currContent), currContent);
 }
 
 void Lexer::_reinitializeKeyWordTree()
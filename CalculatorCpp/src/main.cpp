@@ -7,12 +7,14 @@
 #include <sstream>
 #include <algorithm>
 #include <limits>
+#include <fstream>
 
 #include "lexer.h"
 #include "parser.h"
 #include "evaluation.h"
 #include "initialization.h"
 #include "nodeFactory.h"
+#include "taskPool.h"
 #define DEBUG
 #include "debug.cpp"
 #include <iomanip>
@@ -42,19 +44,19 @@ void test(size_t basicOperationAmount) {
 
 
 	std::cout << "LEXER benckmark (" << basicOperationAmount << " operations) -> ";
-	std::vector<Parser::Lexeme> lexResult;
+	std::vector<Token> lexResult;
 	{
 		BENCHMARK_START;
-		lexResult = lex.lexing(buffer).getValue();
+		lexResult = lex.tokenize(buffer).getValue();
 		BENCHMARK_END;
 	}
 
 
 	std::cout << "PARSER benckmark (" << basicOperationAmount << " operations) -> ";
-	std::vector<Parser::Lexeme> parsedResult;
+	ParsedLexemes parsedResult;
 	{
 		BENCHMARK_START;
-		parsedResult = pas.parseNumbers(lexResult);
+		parsedResult = pas.parseNumbers(buffer, lexResult);
 		BENCHMARK_END;
 	}
 
@@ -81,66 +83,313 @@ void test(size_t basicOperationAmount) {
 	BENCHMARK_END;
 }
 
-//static std::vector<size_t> split_list_equally(const std::vector<size_t>& numbers, size_t m) {
-//	size_t n = numbers.size();
-//	if (n == 0) {
-//		return std::vector<size_t>(m, 0);
-//	}
-//
-//	size_t target_sum = 0;
-//	for (size_t num : numbers) {
-//		target_sum += num;
-//	}
-//	target_sum /= m;
-//
-//	size_t remainder = 0;
-//	for (size_t num : numbers) {
-//		remainder += (num % m);
-//	}
-//
-//	std::vector<size_t> sublists_sum(m, 0);
-//	size_t idx = 0;
-//
-//	for (size_t i = 0; i < m; i++) {
-//		size_t curr_sum = 0;
-//		size_t extra_element = (i < remainder);
-//		size_t start_idx = idx;
-//
-//		while (curr_sum < target_sum + extra_element && idx < n) {
-//			curr_sum += numbers[idx];
-//			idx++;
-//		}
-//
-//		sublists_sum[i] = curr_sum;
-//	}
-//
-//	return sublists_sum;
-//}
-//
-//void loadspliter(const Parser& pas, const std::vector<Parser::Lexeme>& load) {
-//	const unsigned int coresAmount = 4;// std::thread::hardware_concurrency();
-//
-//	std::vector<size_t> delimeters = { 0 };
-//	for (size_t i = 0; i < load.size(); i++) {
-//		if (i == load.size()-1 || pas.isOperator(load[i]) && pas.getOperatorLevel(load[i]) == 0) {
-//			size_t temp = delimeters.back(); delimeters.pop_back();
-//			delimeters.emplace_back(i - temp);
-//			delimeters.emplace_back(i);
-//		}
-//	}
-//	delimeters.pop_back();
-//
-//	std::vector<size_t> splitedListSum{ split_list_equally(delimeters, coresAmount) };
-//	std::vector<size_t> positions;
-//	positions.reserve(splitedListSum.size());
-//	positions.emplace_back(0);
-//	for (auto element : splitedListSum) {
-//		positions.emplace_back(positions.back() + element);
-//	}
-//	
-//	std::cout << delimeters << "\n";
-//	std::cout << positions << "\n";
-//}
+// what the trees evaluate to, or the error of building or evaluating them.
+static std::string resultText(const Result<std::vector<NodeFactory::NodePos>>& root, const Evaluate& eval) {
+	if (root.isError())
+		return root.getException().what();
+	if (auto result = eval.evaluateExpressionTree(root.getValue()); result.isError())
+		return result.getException().what();
+	else
+		return result.getValue().toString();
+}
+
+static std::vector<std::string> evaluateExpressions(const std::vector<std::string>& expressions, Parser::OperatorTreeEngine operatorTreeEngine = Parser::OperatorTreeEngine::PrecedenceClimbing) {
+	Lexer lex;
+	initializeLexer(lex);
+
+	Parser pas;
+	initializeParser(pas);
+	pas.setOperatorTreeEngine(operatorTreeEngine);
+
+	Evaluate eval(pas);
+	initializeEvaluator(eval);
+
+	std::vector<std::string> results;
+	if (const auto parserError{ pas.parserReady() }; parserError.has_value()) {
+		results.assign(expressions.size(), parserError.value().what());
+		return results;
+	}
+
+	results.reserve(expressions.size());
+
+	for (const std::string& expression : expressions) {
+		const NodeFactory::Region expressionRegion{ NodeFactory::mark() };
+
+		std::vector<RawStringSpan> rawStrings;
+		auto lexResult = lex.tokenize(expression, true, &rawStrings);
+		if (lexResult.isError()) {
+			results.emplace_back(lexResult.getException().what());
+			NodeFactory::rewind(expressionRegion);
+			continue;
+		}
+
+		auto parsedResult = pas.parseNumbers(expression, lexResult.getValue(), rawStrings);
+		results.emplace_back(resultText(pas.createOperatorTree(parsedResult, eval.getEvaluationLambdaFunction()), eval));
+
+		NodeFactory::rewind(expressionRegion);
+	}
+
+	return results;
+}
+
+// every '#' of text replaced by number.
+static std::string substitutePlaceholders(std::string text, size_t number) {
+	for (size_t placeholder{ text.find('#') }; placeholder != std::string::npos; placeholder = text.find('#'))
+		text.replace(placeholder, 1, std::to_string(number));
+	return text;
+}
+
+// the same expression evaluated two ways, results must match.
+static void reportResults(const std::string& expected, const std::string& result) {
+	std::cout << (expected == result ? "results match: " : "mismatch: ") << expected << (expected == result ? "" : " != " + result) << "\n";
+}
+
+static std::vector<std::string> templateExpressions(size_t expressionAmount) {
+	// '#' is replaced by a per-expression number.
+	const std::vector<std::string> templates{
+		"#+2*3-#", "2^(# / 10)", "sqrt # + 2", "[1,#] sigma {x; x*x}", "{x; x*2}[#]",
+		"{x, y; x+y}[#, 2]", "sum [3] [#, 2, 3]", "[1, 2, #] @size", "{x; {y; x+y}}[#][2]", "(# + 1) * (3 + 4) / 7",
+	};
+
+	std::vector<std::string> expressions;
+	expressions.reserve(expressionAmount);
+	for (size_t i{ 0 }; i < expressionAmount; i++)
+		expressions.emplace_back(substitutePlaceholders(templates[i % templates.size()], i % 50));
+	return expressions;
+}
+
+// evaluate the same independent expressions on one thread and on every core, results must match.
+void stressTest(size_t expressionAmount) {
+	const std::vector<std::string> expressions{ templateExpressions(expressionAmount) };
+
+	std::cout << "STRESS test (" << expressionAmount << " expressions) -> ";
+	BENCHMARK_START;
+
+	const std::vector<std::string> expected{ evaluateExpressions(expressions) };
+
+	const size_t threadAmount{ std::max<size_t>(std::thread::hardware_concurrency(), 2) };
+	std::vector<std::vector<std::string>> threadExpressions(threadAmount);
+	for (size_t i{ 0 }; i < expressions.size(); i++)
+		threadExpressions[i % threadAmount].emplace_back(expressions[i]);
+
+	std::vector<std::vector<std::string>> threadResults(threadAmount);
+	{
+		std::vector<std::jthread> workers;
+		for (size_t threadIndex{ 0 }; threadIndex < threadAmount; threadIndex++)
+			workers.emplace_back([&, threadIndex]() { threadResults[threadIndex] = evaluateExpressions(threadExpressions[threadIndex]); });
+	}
+
+	size_t mismatches{ 0 };
+	for (size_t i{ 0 }; i < expressions.size(); i++) {
+		if (threadResults[i % threadAmount][i / threadAmount] != expected[i]) {
+			mismatches++;
+			std::cout << "\n\tmismatch: " << expressions[i] << " (" << threadResults[i % threadAmount][i / threadAmount] << " != " << expected[i] << ")";
+		}
+	}
+
+	std::cout << (mismatches ? "\n" : "") << threadAmount << " threads, " << mismatches << " mismatches, ";
+	BENCHMARK_END;
+}
+
+// build the same expressions with the shunting-yard and with the precedence climber, results must match.
+void engineTest(size_t expressionAmount) {
+	const std::vector<std::string> expressions{ templateExpressions(expressionAmount) };
+
+	std::cout << "ENGINE test (" << expressionAmount << " expressions) -> ";
+	BENCHMARK_START;
+
+	const std::vector<std::string> expected{ evaluateExpressions(expressions, Parser::OperatorTreeEngine::ShuntingYard) };
+	const std::vector<std::string> results{ evaluateExpressions(expressions, Parser::OperatorTreeEngine::PrecedenceClimbing) };
+
+	size_t mismatches{ 0 };
+	for (size_t i{ 0 }; i < expressions.size(); i++) {
+		if (results[i] != expected[i]) {
+			mismatches++;
+			std::cout << "\n\tmismatch: " << expressions[i] << " (" << results[i] << " != " << expected[i] << ")";
+		}
+	}
+
+	std::cout << (mismatches ? "\n" : "") << mismatches << " mismatches, ";
+	BENCHMARK_END;
+}
+
+// build one long expression on the calling thread and split over every core, results must match.
+void parallelParseTest(size_t termAmount) {
+	// '#' is replaced by a per-term number.
+	const std::vector<std::string> terms{ "# * 2", "(# + 1) / 7", "2^(# / 10)", "sqrt #", "{x; x*2}[#]", "[1, 2, #] @size" };
+	std::string expression;
+	for (size_t i{ 0 }; i < termAmount; i++)
+		expression += substitutePlaceholders(terms[i % terms.size()], i % 50) + (i % 2 ? " + " : " - ");
+	expression += "1";
+
+	Lexer lex;
+	initializeLexer(lex);
+
+	Parser pas;
+	initializeParser(pas);
+
+	Evaluate eval(pas);
+	initializeEvaluator(eval);
+
+	std::vector<RawStringSpan> rawStrings;
+	const std::vector<Token> tokens{ lex.tokenize(expression, true, &rawStrings).getValue() };
+	const ParsedLexemes parsedResult{ pas.parseNumbers(expression, tokens, rawStrings) };
+	if (const auto parserError{ pas.parserReady() }; parserError.has_value()) {
+		std::cout << parserError.value().what() << "\n";
+		return;
+	}
+
+	const size_t threadAmount{ std::max<size_t>(std::thread::hardware_concurrency(), 2) };
+	std::array<std::string, 2> results;
+	for (const size_t parseThreads : { size_t{ 1 }, threadAmount }) {
+		std::cout << "PARALLEL PARSE test (" << parsedResult.Lexemes.size() << " lexemes, " << parseThreads << " threads) -> ";
+		pas.setParseThreads(parseThreads);
+		const NodeFactory::Region expressionRegion{ NodeFactory::mark() };
+
+		std::string& result{ results[parseThreads > 1] };
+		BENCHMARK_START;
+		auto root = pas.createOperatorTree(parsedResult, eval.getEvaluationLambdaFunction());
+		BENCHMARK_END;
+
+		result = resultText(root, eval);
+
+		NodeFactory::rewind(expressionRegion);
+	}
+
+	reportResults(results[0], results[1]);
+}
+
+// balanced operator trees (their operands are independent) and a storage of them, evaluated without and with pool workers.
+void parallelEvaluateTest(size_t depth) {
+	const std::vector<std::string> operators{ " + ", " * ", " - ", " / " };
+	std::vector<std::string> level;
+	for (size_t i{ 0 }; i < (size_t{ 1 } << depth); i++)
+		level.emplace_back(std::to_string(i % 9 + 1));
+	for (size_t height{ 0 }; level.size() > 1; height++) {
+		std::vector<std::string> upper;
+		for (size_t i{ 0 }; i + 1 < level.size(); i += 2)
+			upper.emplace_back("(" + level[i] + operators[(height + i) % operators.size()] + level[i + 1] + ")");
+		level = std::move(upper);
+	}
+	const std::string& tree{ level.front() };
+	const std::vector<std::string> expressions{ tree, "(" + tree + ") && (" + tree + ") || (" + tree + ")", "[" + tree + ", " + tree + ", sqrt " + tree + "]" };
+
+	Lexer lex;
+	initializeLexer(lex);
+
+	Parser pas;
+	initializeParser(pas);
+
+	Evaluate eval(pas);
+	initializeEvaluator(eval);
+
+	if (const auto parserError{ pas.parserReady() }; parserError.has_value()) {
+		std::cout << parserError.value().what() << "\n";
+		return;
+	}
+
+	const size_t workerAmount{ TaskPool::instance().workerAmount() };
+	for (const std::string& expression : expressions) {
+		std::array<std::string, 2> results;
+		for (const size_t workers : { size_t{ 0 }, std::max<size_t>(workerAmount, 1) }) {
+			std::cout << "PARALLEL EVALUATE test (" << expression.size() << " characters, " << workers << " workers) -> ";
+			TaskPool::instance().setWorkerAmount(workers);
+			const NodeFactory::Region expressionRegion{ NodeFactory::mark() };
+
+			std::string& result{ results[workers > 0] };
+			std::vector<RawStringSpan> rawStrings;
+			const std::vector<Token> tokens{ lex.tokenize(expression, true, &rawStrings).getValue() };
+			auto root = pas.createOperatorTree(pas.parseNumbers(expression, tokens, rawStrings), eval.getEvaluationLambdaFunction());
+
+			BENCHMARK_START;
+			result = resultText(root, eval);
+			BENCHMARK_END;
+
+			NodeFactory::rewind(expressionRegion);
+		}
+
+		reportResults(results[0], results[1]);
+	}
+	TaskPool::instance().setWorkerAmount(workerAmount);
+}
+
+// parameters named like the numbers std::from_chars reads ("nan", "inf", ...) stand for their argument, results must match.
+void numberSpellingTest() {
+	const std::vector<std::pair<std::string, std::string>> cases{
+		{ "{nan; nan+1}[2]", "3.000000" },
+		{ "{inf; inf*2}[3]", "6.000000" },
+		{ "{INF; INF*2}[3]", "6.000000" },
+		{ "{Infinity; Infinity-1}[3]", "2.000000" },
+		{ "[1,5] sigma {inf; inf*2}", "20.000000" },
+	};
+
+	std::vector<std::string> expressions;
+	for (const auto& [expression, _] : cases)
+		expressions.emplace_back(expression);
+	const std::vector<std::string> results{ evaluateExpressions(expressions) };
+
+	for (size_t i{ 0 }; i < cases.size(); i++) {
+		std::cout << "NUMBER SPELLING test (" << expressions[i] << ") -> ";
+		reportResults(cases[i].second, results[i]);
+	}
+}
+
+// the file is one expression, read and lexed a chunk at a time, so it never has to fit in memory as text.
+static int evaluateFile(const Lexer& lex, Parser& pas, const Evaluate& eval, const std::string& path) {
+	constexpr size_t chunkSize{ 1 << 20 };
+
+	std::ifstream file(path, std::ios::binary);
+	if (!file) {
+		std::cout << ColorText<Color::Red>("(!) ") << "Could not open \"" << path << "\".\n";
+		return 1;
+	}
+
+	if (const auto parserError{ pas.parserReady() }; parserError.has_value()) {
+		std::cout << ColorText<Color::Red>("(!) ") << HighlightSyntax(parserError.value().what()) << "\n";
+		return 1;
+	}
+
+	TokenStream tokenStream{ lex.tokenStream(true) };
+	Parser::ExpressionStream expressionStream{ pas, eval.getEvaluationLambdaFunction() };
+	std::string chunk(chunkSize, '\0');
+	std::vector<Token> tokens;
+
+	BENCHMARK_START;
+	while (file) {
+		file.read(chunk.data(), chunk.size());
+		tokens.clear();
+		tokenStream.feed(std::string_view(chunk.data(), static_cast<size_t>(file.gcount())), tokens);
+		if (tokenStream.unvalidPositions().size())
+			break;
+		expressionStream.feed(tokenStream, tokens);
+	}
+
+	if (tokenStream.unvalidPositions().empty()) {
+		tokens.clear();
+		tokenStream.finish(tokens);
+		expressionStream.feed(tokenStream, tokens);
+	}
+
+	if (const std::vector<size_t>& unvalidPositions{ tokenStream.unvalidPositions() }; unvalidPositions.size()) {
+		std::cout << ColorText<Color::Red>("(!) ") << "Found unvalid characters While attempting to lex \"" << path << "\" at offset " << unvalidPositions.front() << ".\n";
+		return 1;
+	}
+
+	auto root = expressionStream.finish();
+	if (root.isError()) {
+		std::cout << ColorText<Color::Red>("(!) ") << HighlightSyntax(root.getException().what()) << "\n";
+		return 1;
+	}
+
+	if (auto result = eval.evaluateExpressionTree(root.moveValue()); !result.isError())
+		std::cout << ColorText<Color::Green>(" ≡ ") << std::fixed << HighlightSyntax(result.getValue().toString()) << "\n";
+	else {
+		std::cout << ColorText<Color::Red>(" (!) ") << HighlightSyntax(result.getException().what()) << "\n";
+		return 1;
+	}
+	BENCHMARK_END;
+	return 0;
+}
 
 int main(int argc, char* argv[])
 {
@@ -149,16 +398,35 @@ int main(int argc, char* argv[])
 	 //test(1'000'000); //  2.1 second (best)
 	 //return 0;
 
+	 //stressTest(10'000);
+	 //return 0;
+
+	 //engineTest(10'000);
+	 //return 0;
+
+	 //parallelParseTest(200'000);
+	 //return 0;
+
+	 //parallelEvaluateTest(17);
+	 //return 0;
+
+	 //numberSpellingTest();
+	 //return 0;
+
 	Lexer lex;
 	initializeLexer(lex);
 
 	Parser pas;
 	initializeParser(pas);
+	pas.setParseThreads(std::thread::hardware_concurrency());
 
 	Evaluate eval(pas);
 	initializeEvaluator(eval);
 
 
+	if (argc >= 3 && std::string_view(argv[1]) == "--file")
+		return evaluateFile(lex, pas, eval, argv[2]);
+
 	std::string input{};
 	if (argc >= 2) {
 		input = argv[1];
@@ -177,26 +445,33 @@ int main(int argc, char* argv[])
 
 		// debug tool make it better later
 		if (input == ":node-profile") {
-			size_t nodePosition{ 0 };
-			while (NodeFactory::validNode(nodePosition)) {
+			for (size_t slotIndex{ 0 }; slotIndex < NodeFactory::size(); slotIndex++) {
+				const NodeFactory::NodePos nodePosition{ NodeFactory::handle(slotIndex) };
+				if (!NodeFactory::validNode(nodePosition))
+					continue;
+
 				const NodeFactory::Node& nNode{ NodeFactory::node(nodePosition) };
 				std::string utilityStorageString;
-				for (const auto& [paramName, paramType] : nNode.utilityStorage) {
+				for (const auto& [paramName, paramType] : nNode.utilityStorage()) {
 					utilityStorageString += paramName + ": " + RuntimeTypeToString(paramType) + ", ";
 				}
-				if (nNode.utilityStorage.size()) {
+				if (nNode.utilityStorage().size()) {
 					utilityStorageString.pop_back();
 					utilityStorageString.pop_back();
 				}
-				std::cout << std::format("Node({}): \n\t value-----\t: \"{}\" \n\t nodeState-\t: {}\n\t leftPos---\t: {} \n\t rightPos--\t: {} \n\t paramsType\t: [{}]\n", nodePosition, nNode.value, (int)nNode.nodestate, nNode.leftPos, nNode.rightPos, utilityStorageString);
-				nodePosition++;
+				std::cout << std::format("Node({}): \n\t value-----\t: \"{}\" \n\t nodeState-\t: {}\n\t leftPos---\t: {} \n\t rightPos--\t: {} \n\t paramsType\t: [{}]\n", nodePosition, nNode.value(), (int)nNode.nodestate, nNode.leftPos, nNode.rightPos, utilityStorageString);
 			}
 		}
 
-		auto lexResult = lex.lexing(input, true);
+		// every node of this expression is given back once it's evaluated (values stored with := are pinned).
+		const NodeFactory::Region expressionRegion{ NodeFactory::mark() };
+
+		std::vector<RawStringSpan> rawStrings;
+		auto lexResult = lex.tokenize(input, true, &rawStrings);
 
 		if (lexResult.isError()) {	
 			std::cout << lexResult.getException().what() << "\n\n";
+			NodeFactory::rewind(expressionRegion);
 			continue;
 		}
 
@@ -205,9 +480,7 @@ int main(int argc, char* argv[])
 
 		//std::cout << "Lexing: " << HighlightSyntax(ss.str().substr(0, 1000)) << "\n";
 
-		auto parsedResult = pas.parseNumbers(lexResult.getValue());
-
-		// loadspliter(pas, parsedResult);
+		auto parsedResult = pas.parseNumbers(input, lexResult.getValue(), rawStrings);
 
 		//ss.str("");
 		//ss.clear();
@@ -231,15 +504,14 @@ int main(int argc, char* argv[])
 				else
 					std::cout << ColorText<Color::Red>(" (!) ") << HighlightSyntax(result.getException().what()) << "\n";
 				BENCHMARK_END;
-
-				// NodeFactory::freeAll();
 			}
 			else {
 				std::cout << ColorText<Color::Red>("(!) ") << HighlightSyntax(root.getException().what()) << "\n";
 			}
 		}
 
-		std::cout << "Node amount: " << NodeFactory::size() << "\n";
+		NodeFactory::rewind(expressionRegion);
+		std::cout << "Node amount: " << NodeFactory::liveSize() << "\n";
 		std::cout << std::endl;
 	}
 
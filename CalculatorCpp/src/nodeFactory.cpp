@@ -1,62 +1,571 @@
 #include "nodeFactory.h"
+#include "numberText.h"
 
-NodeFactory& NodeFactory::iGetInstance() {
-	static NodeFactory instance;
+#include <algorithm>
+#include <thread>
+
+NodeFactory& NodeFactory::iDefaultInstance() {
+	thread_local NodeFactory instance;
 	return instance;
 }
 
 void NodeFactory::iFreeAll() {
-	mNodeData.clear();
+	// every handle issued so far must stay stale, so new slots start above every generation seen.
+	for (Generation generation : mGenerations)
+		mGenerationFloor = std::max(mGenerationFloor, generation + 1);
+
+	mStates.clear();
+	mLeftPos.clear();
+	mRightPos.clear();
+	mSymbols.clear();
+	mNumbers.clear();
+	mGenerations.clear();
+	mFlags.clear();
+	mParameters.clear();
+	mTypes.clear();
+	mPrograms.clear();
+	mFreeList.clear();
+	mRegionReused.clear();
+	mPinnedRoots.clear();
+	mUnpinnedRoots.clear();
+
+	// no slot uses any symbol anymore.
+	mSymbolText.clear();
+	mSymbolNumber.clear();
+	mSymbolIsNumber.clear();
+	mSymbolUses.clear();
+	mSymbolIds.clear();
+	mUnusedSymbols.clear();
+	mFreeSymbols.clear();
+}
+
+NodeFactory::SymbolId NodeFactory::iIntern(std::string_view value) {
+	if (auto symbolIt{ mSymbolIds.find(value) }; symbolIt != mSymbolIds.end())
+		return symbolIt->second;
+
+	// number literals are parsed once per distinct spelling.
+	const std::optional<long double> number{ parseNumberLiteral(value) };
+
+	SymbolId symbol;
+	if (!mFreeSymbols.empty()) {
+		symbol = mFreeSymbols.back();
+		mFreeSymbols.pop_back();
+		mSymbolText[symbol] = value;
+		mSymbolNumber[symbol] = number.value_or(0);
+		mSymbolIsNumber[symbol] = number.has_value();
+	}
+	else {
+		symbol = static_cast<SymbolId>(mSymbolText.size());
+		mSymbolText.emplace_back(value);
+		mSymbolNumber.emplace_back(number.value_or(0));
+		mSymbolIsNumber.emplace_back(number.has_value());
+		mSymbolUses.emplace_back(0);
+	}
+
+	mUnusedSymbols.emplace_back(symbol); // unused until a slot takes it.
+	mSymbolIds.emplace(value, symbol);
+	return symbol;
+}
+
+void NodeFactory::iUseSymbol(SymbolId symbol) {
+	if (symbol != SymbolNull)
+		mSymbolUses[symbol]++;
+}
+
+void NodeFactory::iDropSymbol(uint32_t slotIndex) {
+	const SymbolId symbol{ mSymbols[slotIndex] };
+	mSymbols[slotIndex] = SymbolNull;
+	if (symbol != SymbolNull && --mSymbolUses[symbol] == 0)
+		mUnusedSymbols.emplace_back(symbol);
+}
+
+// a symbol can be listed more than once (used again in between), only the ones still unused and interned are dropped.
+void NodeFactory::iReleaseSymbols() {
+	for (const SymbolId symbol : mUnusedSymbols) {
+		if (mSymbolUses[symbol] != 0)
+			continue;
+
+		const auto symbolIt{ mSymbolIds.find(mSymbolText[symbol]) };
+		if (symbolIt == mSymbolIds.end() || symbolIt->second != symbol)
+			continue;
+
+		mSymbolIds.erase(symbolIt);
+		mSymbolText[symbol] = std::string{};
+		mFreeSymbols.emplace_back(symbol);
+	}
+	mUnusedSymbols.clear();
 }
 
-NodeFactory::NodePos NodeFactory::iCreate(const std::string& value) {
-	mNodeData.emplace_back(value);
-	return static_cast<NodePos>(mNodeData.size()) - 1;
+void NodeFactory::iSetSymbol(uint32_t slotIndex, SymbolId symbol) {
+	iUseSymbol(symbol);
+	iDropSymbol(slotIndex);
+	mSymbols[slotIndex] = symbol;
+	mNumbers[slotIndex] = mSymbolNumber[symbol];
+	mFlags[slotIndex] = mSymbolIsNumber[symbol] ? (mFlags[slotIndex] | NodeFlag::Numeric) : (mFlags[slotIndex] & ~NodeFlag::Numeric);
+	mFlags[slotIndex] &= ~NodeFlag::Parameter; // a new value no longer refers to the parameter.
+	iClearType(slotIndex);
+}
+
+void NodeFactory::iClearType(uint32_t slotIndex) {
+	if (!(mFlags[slotIndex] & NodeFlag::Typed))
+		return;
+
+	mTypes.erase(slotIndex);
+	mFlags[slotIndex] &= ~NodeFlag::Typed;
+}
+
+void NodeFactory::iClearProgram(uint32_t slotIndex) {
+	if (!(mFlags[slotIndex] & NodeFlag::Compiled))
+		return;
+
+	mPrograms.erase(slotIndex);
+	mFlags[slotIndex] &= ~NodeFlag::Compiled;
+}
+
+NodeFactory::NodePos NodeFactory::iCreate(SymbolId symbol, long double number, bool isNumber) {
+	const uint8_t flags{ static_cast<uint8_t>(isNumber ? NodeFlag::Numeric : 0) };
+
+	if (!mFreeList.empty()) {
+		const uint32_t slotIndex{ mFreeList.back() };
+		mFreeList.pop_back();
+
+		mStates[slotIndex] = Node::NodeState::Number;
+		mLeftPos[slotIndex] = NodePosNull;
+		mRightPos[slotIndex] = NodePosNull;
+		mSymbols[slotIndex] = symbol;
+		iUseSymbol(symbol);
+		mNumbers[slotIndex] = number;
+		mFlags[slotIndex] = flags;
+		if (mOpenRegions)
+			mRegionReused.emplace_back(slotIndex);
+
+		return makeHandle(slotIndex, mGenerations[slotIndex]);
+	}
+
+	mStates.emplace_back(Node::NodeState::Number);
+	mLeftPos.emplace_back(NodePosNull);
+	mRightPos.emplace_back(NodePosNull);
+	mSymbols.emplace_back(symbol);
+	iUseSymbol(symbol);
+	mNumbers.emplace_back(number);
+	mGenerations.emplace_back(mGenerationFloor);
+	mFlags.emplace_back(flags);
+	return makeHandle(static_cast<uint32_t>(mStates.size() - 1), mGenerationFloor);
+}
+
+void NodeFactory::iReleaseSlot(uint32_t slotIndex) {
+	if (mFlags[slotIndex] & (NodeFlag::Free | NodeFlag::Pinned))
+		return;
+
+	if (mFlags[slotIndex] & NodeFlag::HasParameters)
+		mParameters.erase(slotIndex);
+	if (mFlags[slotIndex] & NodeFlag::Typed)
+		mTypes.erase(slotIndex);
+	if (mFlags[slotIndex] & NodeFlag::Compiled)
+		mPrograms.erase(slotIndex);
+
+	iDropSymbol(slotIndex);
+	mLeftPos[slotIndex] = NodePosNull;
+	mRightPos[slotIndex] = NodePosNull;
+	mGenerations[slotIndex]++; // outstanding handles of this slot become stale.
+	mFlags[slotIndex] = NodeFlag::Free;
+	mFreeList.emplace_back(slotIndex);
+}
+
+// pinned nodes are skipped with everything under them, shared nodes are only released once (their handle turns stale).
+void NodeFactory::iReleaseTree(NodePos root) {
+	std::vector<NodePos> stack{ root };
+
+	while (!stack.empty()) {
+		const NodePos currNodePos{ stack.back() };
+		stack.pop_back();
+
+		if (!iValidNode(currNodePos) || (mFlags[slotOf(currNodePos)] & NodeFlag::Pinned))
+			continue;
+
+		stack.emplace_back(mLeftPos[slotOf(currNodePos)]);
+		stack.emplace_back(mRightPos[slotOf(currNodePos)]);
+		iReleaseSlot(slotOf(currNodePos));
+	}
+}
+
+// pins aren't counted per node, so the unpinned trees are cleared first and every pinned root marks its whole tree
+// again (a subtree it shares with an unpinned tree lost its flag). Whatever stays unpinned is given back.
+void NodeFactory::iReleaseUnpinned() {
+	if (mUnpinnedRoots.empty())
+		return;
+
+	for (const NodePos root : mUnpinnedRoots)
+		iSetPinned(root, false);
+
+	std::vector<bool> visited(mStates.size());
+	std::vector<NodePos> stack{ mPinnedRoots };
+	while (!stack.empty()) {
+		const NodePos currNodePos{ stack.back() };
+		stack.pop_back();
+
+		if (!iValidNode(currNodePos) || visited[slotOf(currNodePos)])
+			continue;
+
+		visited[slotOf(currNodePos)] = true;
+		mFlags[slotOf(currNodePos)] |= NodeFlag::Pinned;
+		stack.emplace_back(mLeftPos[slotOf(currNodePos)]);
+		stack.emplace_back(mRightPos[slotOf(currNodePos)]);
+	}
+
+	for (const NodePos root : mUnpinnedRoots)
+		iReleaseTree(root);
+	mUnpinnedRoots.clear();
+}
+
+void NodeFactory::iPopSlot() {
+	mStates.pop_back();
+	mLeftPos.pop_back();
+	mRightPos.pop_back();
+	mSymbols.pop_back();
+	mNumbers.pop_back();
+	mGenerations.pop_back();
+	mFlags.pop_back();
+}
+
+void NodeFactory::iRewind(const Region& region) {
+	const bool outermost{ mOpenRegions <= 1 };
+	if (outermost)
+		iReleaseUnpinned();
+
+	for (size_t ind{ region.mReusedMark }; ind < mRegionReused.size(); ind++)
+		iReleaseSlot(mRegionReused[ind]);
+	mRegionReused.resize(std::min(region.mReusedMark, mRegionReused.size()));
+
+	for (size_t slotIndex{ region.mSizeMark }; slotIndex < mStates.size(); slotIndex++)
+		iReleaseSlot(static_cast<uint32_t>(slotIndex));
+
+	// give the free tail back to the columns, pinned nodes keep the slots below them alive.
+	bool truncated{ false };
+	while (!mFlags.empty() && (mFlags.back() & NodeFlag::Free)) {
+		mGenerationFloor = std::max(mGenerationFloor, mGenerations.back());
+		iPopSlot();
+		truncated = true;
+	}
+
+	if (truncated)
+		std::erase_if(mFreeList, [this](uint32_t slotIndex) { return slotIndex >= mStates.size(); });
+
+	if (outermost)
+		iReleaseSymbols();
+	if (mOpenRegions)
+		mOpenRegions--;
+}
+
+void NodeFactory::iKeep(const Region& region) {
+	if (mOpenRegions <= 1) {
+		iReleaseUnpinned();
+		iReleaseSymbols();
+	}
+	if (mOpenRegions)
+		mOpenRegions--;
+
+	// slots reused inside the region are only listed for the regions around it.
+	if (!mOpenRegions)
+		mRegionReused.resize(std::min(region.mReusedMark, mRegionReused.size()));
+}
+
+void NodeFactory::iAdopt(std::span<NodeFactory* const> sources, std::span<std::vector<NodePos>> handles) {
+	// the symbols of a source are interned here first, the copies only translate them.
+	std::vector<size_t> offsets;
+	std::vector<std::vector<SymbolId>> symbols(sources.size());
+	size_t size{ mStates.size() };
+	for (size_t ind{ 0 }; ind < sources.size(); ind++) {
+		offsets.emplace_back(size);
+		size += sources[ind]->mStates.size();
+
+		symbols[ind].reserve(sources[ind]->mSymbolText.size());
+		for (const std::string& text : sources[ind]->mSymbolText)
+			symbols[ind].emplace_back(iIntern(text));
+	}
+
+	mStates.resize(size);
+	mLeftPos.resize(size);
+	mRightPos.resize(size);
+	mSymbols.resize(size);
+	mNumbers.resize(size);
+	mGenerations.resize(size, mGenerationFloor);
+	mFlags.resize(size);
+
+	const auto copySource{ [&](size_t ind) {
+		iCopySlots(*sources[ind], offsets[ind], symbols[ind]);
+		if (ind < handles.size())
+			for (NodePos& handle : handles[ind])
+				handle = iRelocate(*sources[ind], offsets[ind], handle);
+	} };
+
+	if (sources.size() == 1)
+		copySource(0);
+	else {
+		std::vector<std::jthread> copiers;
+		for (size_t ind{ 0 }; ind < sources.size(); ind++)
+			copiers.emplace_back(copySource, ind);
+	}
+
+	for (size_t ind{ 0 }; ind < sources.size(); ind++) {
+		for (size_t slotIndex{ offsets[ind] }; slotIndex < offsets[ind] + sources[ind]->mStates.size(); slotIndex++)
+			iUseSymbol(mSymbols[slotIndex]);
+		for (auto& [slotIndex, parameters] : sources[ind]->mParameters)
+			mParameters.emplace(static_cast<uint32_t>(offsets[ind] + slotIndex), std::move(parameters));
+		for (auto& [slotIndex, type] : sources[ind]->mTypes)
+			mTypes.emplace(static_cast<uint32_t>(offsets[ind] + slotIndex), std::move(type));
+		for (uint32_t slotIndex : sources[ind]->mFreeList)
+			mFreeList.emplace_back(static_cast<uint32_t>(offsets[ind] + slotIndex));
+		sources[ind]->iFreeAll();
+	}
 }
 
-NodeFactory::Node& NodeFactory::iNode(NodePos index) {
-	return mNodeData[index];
+void NodeFactory::iCopySlots(const NodeFactory& source, size_t offset, const std::vector<SymbolId>& symbols) {
+	for (size_t slotIndex{ 0 }; slotIndex < source.mStates.size(); slotIndex++) {
+		const size_t copyIndex{ offset + slotIndex };
+		mStates[copyIndex] = source.mStates[slotIndex];
+		mLeftPos[copyIndex] = iRelocate(source, offset, source.mLeftPos[slotIndex]);
+		mRightPos[copyIndex] = iRelocate(source, offset, source.mRightPos[slotIndex]);
+		mSymbols[copyIndex] = source.mSymbols[slotIndex] == SymbolNull ? SymbolNull : symbols[source.mSymbols[slotIndex]];
+		mNumbers[copyIndex] = source.mNumbers[slotIndex];
+		mFlags[copyIndex] = source.mFlags[slotIndex] & ~NodeFlag::Compiled; // programs hold handles of the source.
+	}
 }
 
-bool NodeFactory::iValidNode(NodePos index) const {
-	return (index < mNodeData.size());
+// links to released slots of the source are dropped, they'd look valid once moved.
+NodeFactory::NodePos NodeFactory::iRelocate(const NodeFactory& source, size_t offset, NodePos index) const {
+	if (!source.iValidNode(index))
+		return NodePosNull;
+	return makeHandle(static_cast<uint32_t>(offset + slotOf(index)), mGenerationFloor);
 }
 
-NodeFactory::Node& NodeFactory::node(NodePos index) {
-	return iGetInstance().iNode(index);
+void NodeFactory::iSetPinned(NodePos root, bool pinned) {
+	std::vector<NodePos> stack{ root };
+
+	while (!stack.empty()) {
+		const NodePos currNodePos{ stack.back() };
+		stack.pop_back();
+
+		if (!iValidNode(currNodePos))
+			continue;
+
+		const uint32_t slotIndex{ slotOf(currNodePos) };
+		uint8_t& flags{ mFlags[slotIndex] };
+		if (static_cast<bool>(flags & NodeFlag::Pinned) == pinned)
+			continue; // already visited (shared subtree).
+
+		flags = pinned ? (flags | NodeFlag::Pinned) : (flags & ~NodeFlag::Pinned);
+		stack.emplace_back(mLeftPos[slotIndex]);
+		stack.emplace_back(mRightPos[slotIndex]);
+	}
 }
-NodeFactory::NodePos NodeFactory::create(const std::string& value) {
-	return iGetInstance().iCreate(value);
+
+NodeFactory::NodePos NodeFactory::create(std::string_view value) {
+	NodeFactory& instance{ iGetInstance() };
+	const SymbolId symbol{ instance.iIntern(value) };
+	return instance.iCreate(symbol, instance.mSymbolNumber[symbol], instance.mSymbolIsNumber[symbol]);
 }
 
-bool NodeFactory::validNode(NodePos index) {
-	return iGetInstance().iValidNode(index);
+NodeFactory::NodePos NodeFactory::createNumber(long double number) {
+	// the text of a computed number is only interned when someone asks for value().
+	return iGetInstance().iCreate(SymbolNull, number, true);
 }
 
 void NodeFactory::reserve(size_t amount) {
-	iGetInstance().mNodeData.reserve(amount);
+	NodeFactory& instance{ iGetInstance() };
+	instance.mStates.reserve(amount);
+	instance.mLeftPos.reserve(amount);
+	instance.mRightPos.reserve(amount);
+	instance.mSymbols.reserve(amount);
+	instance.mNumbers.reserve(amount);
+	instance.mGenerations.reserve(amount);
+	instance.mFlags.reserve(amount);
 }
 
 size_t NodeFactory::size() {
-	return iGetInstance().mNodeData.size();
+	return iGetInstance().mStates.size();
+}
+
+size_t NodeFactory::capacity() {
+	return iGetInstance().mStates.capacity();
+}
+
+size_t NodeFactory::liveSize() {
+	return iGetInstance().mStates.size() - iGetInstance().mFreeList.size();
+}
+
+void NodeFactory::clearTypes() {
+	NodeFactory& instance{ iGetInstance() };
+	for (const auto& [slotIndex, _] : instance.mTypes)
+		instance.mFlags[slotIndex] &= ~NodeFlag::Typed;
+	instance.mTypes.clear();
 }
 
 void NodeFactory::freeAll() {
 	iGetInstance().iFreeAll();
 }
 
-NodeFactory::Node::Node(const std::string& value) : value{ value } {}
+NodeFactory::Region NodeFactory::mark() {
+	NodeFactory& instance{ iGetInstance() };
+	Region region;
+	region.mSizeMark = instance.mStates.size();
+	region.mReusedMark = instance.mRegionReused.size();
+	instance.mOpenRegions++;
+	return region;
+}
+
+void NodeFactory::rewind(const Region& region) {
+	iGetInstance().iRewind(region);
+}
 
-NodeFactory::Node& NodeFactory::Node::rightNode() {
-	return NodeFactory::iGetInstance().iNode(rightPos);
+void NodeFactory::keep(const Region& region) {
+	iGetInstance().iKeep(region);
 }
 
-NodeFactory::Node& NodeFactory::Node::leftNode() {
-	return NodeFactory::iGetInstance().iNode(leftPos);
+void NodeFactory::adopt(std::span<NodeFactory* const> sources, std::span<std::vector<NodePos>> handles) {
+	iGetInstance().iAdopt(sources, handles);
 }
 
-bool NodeFactory::Node::operator==(const Node& other) const {
-	return (value == other.value && nodestate == other.nodestate && utilityStorage == other.utilityStorage);
+void NodeFactory::release(NodePos index) {
+	if (validNode(index))
+		iGetInstance().iReleaseSlot(slotOf(index));
+}
+
+void NodeFactory::pin(NodePos root) {
+	NodeFactory& instance{ iGetInstance() };
+	instance.iSetPinned(root, true);
+	instance.mPinnedRoots.emplace_back(root);
+}
+
+void NodeFactory::unpin(NodePos root) {
+	NodeFactory& instance{ iGetInstance() };
+	const auto rootIt{ std::find(instance.mPinnedRoots.rbegin(), instance.mPinnedRoots.rend(), root) };
+	if (rootIt == instance.mPinnedRoots.rend())
+		return;
+
+	instance.mPinnedRoots.erase(std::next(rootIt).base());
+	if (std::find(instance.mPinnedRoots.begin(), instance.mPinnedRoots.end(), root) != instance.mPinnedRoots.end())
+		return;
+
+	instance.mUnpinnedRoots.emplace_back(root);
+	if (!instance.mOpenRegions)
+		instance.iReleaseUnpinned();
+}
+
+NodeFactory::NodePos NodeFactory::handle(size_t slotIndex) {
+	NodeFactory& instance{ iGetInstance() };
+	if (slotIndex >= instance.mStates.size() || (instance.mFlags[slotIndex] & NodeFlag::Free))
+		return NodePosNull;
+	return makeHandle(static_cast<uint32_t>(slotIndex), instance.mGenerations[slotIndex]);
+}
+
+NodeFactory::ScopedRegion::ScopedRegion() : mRegion{ NodeFactory::mark() } {}
+
+NodeFactory::ScopedRegion::~ScopedRegion() {
+	NodeFactory::rewind(mRegion);
+}
+
+NodeFactory::Scope::Scope(NodeFactory& factory) : mPrevious{ mCurrentInstance } {
+	mCurrentInstance = &factory;
 }
 
+NodeFactory::Scope::~Scope() {
+	mCurrentInstance = mPrevious;
+}
+
+const std::string& NodeFactory::Node::value() const {
+	if (mFactory.mSymbols[mSlotIndex] == SymbolNull) {
+		const SymbolId symbol{ mFactory.iIntern(formatNumber(mFactory.mNumbers[mSlotIndex])) };
+		mFactory.mSymbols[mSlotIndex] = symbol;
+		mFactory.iUseSymbol(symbol);
+	}
+	return mFactory.mSymbolText[mFactory.mSymbols[mSlotIndex]];
+}
 
+void NodeFactory::Node::setValue(const std::string& value) {
+	mFactory.iSetSymbol(mSlotIndex, mFactory.iIntern(value));
+}
+
+void NodeFactory::Node::setNumber(long double number) {
+	nodestate = NodeState::Number;
+	leftPos = NodePosNull;
+	rightPos = NodePosNull;
+	mFactory.iDropSymbol(mSlotIndex); // interned lazily by value(), like createNumber.
+	mFactory.mNumbers[mSlotIndex] = number;
+	mFactory.mFlags[mSlotIndex] = (mFactory.mFlags[mSlotIndex] | NodeFlag::Numeric) & ~NodeFlag::Parameter;
+	mFactory.iClearType(mSlotIndex);
+	mFactory.iClearProgram(mSlotIndex);
+}
+
+void NodeFactory::Node::setParameterSlot(uint32_t slot) {
+	mFactory.mNumbers[mSlotIndex] = static_cast<long double>(slot);
+	mFactory.mFlags[mSlotIndex] = (mFactory.mFlags[mSlotIndex] | NodeFlag::Parameter) & ~NodeFlag::Numeric;
+	mFactory.iClearType(mSlotIndex);
+}
+
+bool NodeFactory::Node::isFolded() const {
+	return mFactory.mFlags[mSlotIndex] & NodeFlag::Folded;
+}
+
+void NodeFactory::Node::setFolded() {
+	mFactory.mFlags[mSlotIndex] |= NodeFlag::Folded;
+}
+
+void NodeFactory::Node::setType(const RuntimeType& type) {
+	mFactory.mTypes.insert_or_assign(mSlotIndex, type);
+	mFactory.mFlags[mSlotIndex] |= NodeFlag::Typed;
+}
+
+void NodeFactory::Node::clearType() {
+	mFactory.iClearType(mSlotIndex);
+}
+
+std::shared_ptr<const Bytecode> NodeFactory::Node::program() const {
+	if (!(mFactory.mFlags[mSlotIndex] & NodeFlag::Compiled))
+		return nullptr;
+	return mFactory.mPrograms.find(mSlotIndex)->second;
+}
+
+void NodeFactory::Node::setProgram(std::shared_ptr<const Bytecode> program) {
+	mFactory.mPrograms.insert_or_assign(mSlotIndex, std::move(program));
+	mFactory.mFlags[mSlotIndex] |= NodeFlag::Compiled;
+}
+
+void NodeFactory::Node::clearProgram() {
+	mFactory.iClearProgram(mSlotIndex);
+}
+
+const NodeFactory::ParameterList& NodeFactory::Node::utilityStorage() const {
+	static const ParameterList noParameters;
+	if (!(mFactory.mFlags[mSlotIndex] & NodeFlag::HasParameters))
+		return noParameters;
+
+	const auto parametersIt{ mFactory.mParameters.find(mSlotIndex) };
+	return (parametersIt != mFactory.mParameters.end()) ? parametersIt->second : noParameters;
+}
+
+void NodeFactory::Node::setUtilityStorage(const ParameterList& parameters) {
+	mFactory.iClearType(mSlotIndex); // the parameters are part of the lambda type.
+
+	uint8_t& flags{ mFactory.mFlags[mSlotIndex] };
+	if (parameters.empty()) {
+		mFactory.mParameters.erase(mSlotIndex);
+		flags &= ~NodeFlag::HasParameters;
+	}
+	else {
+		mFactory.mParameters[mSlotIndex] = parameters;
+		flags |= NodeFlag::HasParameters;
+	}
+}
+
+NodeFactory::Node NodeFactory::Node::rightNode() const {
+	return mFactory.iNode(rightPos);
+}
+
+NodeFactory::Node NodeFactory::Node::leftNode() const {
+	return mFactory.iNode(leftPos);
+}
+
+bool NodeFactory::Node::operator==(const Node& other) const {
+	return (symbol() == other.symbol() && nodestate == other.nodestate && utilityStorage() == other.utilityStorage());
+}
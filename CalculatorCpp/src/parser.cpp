@@ -13,6 +13,9 @@
 #include <format>
 #include <regex>
 #include <algorithm>
+#include <array>
+#include <functional>
+#include <thread>
 
 #include "parser.h"
 #include "runtimeType.h"
@@ -32,13 +35,13 @@
 constexpr size_t STACK_CALL_LIMIT = 200;
 
 static int randomNumber() {
-	static std::mt19937 gen(static_cast<unsigned int>(std::chrono::system_clock::now().time_since_epoch().count()));
-	static std::uniform_int_distribution dis(0, 16777215);
+	thread_local std::mt19937 gen(static_cast<unsigned int>(std::chrono::system_clock::now().time_since_epoch().count()));
+	thread_local std::uniform_int_distribution dis(0, 16777215);
 
 	return dis(gen);
 }
 
-static bool isNumber(const std::string& lexeme) {
+static bool isNumber(std::string_view lexeme) {
 	if (lexeme.empty())
 		return false;
 	if (lexeme.length() == 1 && (lexeme[0] == '-' || lexeme[0] == '.'))
@@ -52,7 +55,7 @@ static bool isNumber(const std::string& lexeme) {
 	return std::isdigit(lexeme[lexeme.front() == '-' || lexeme.front() == '.']);
 }
 
-bool Parser::strictedIsNumber(const std::string& lexeme, bool veryStrict) {
+bool Parser::strictedIsNumber(std::string_view lexeme, bool veryStrict) {
 	if (lexeme.empty())
 		return false;
 
@@ -60,10 +63,12 @@ bool Parser::strictedIsNumber(const std::string& lexeme, bool veryStrict) {
 		return true && !veryStrict;
 
 	if ((lexeme.length() >= 2 && (lexeme[0] == '-' && lexeme[1] == '.') && (std::isdigit(lexeme.back()) || lexeme.length() <= 2))
-		|| ((lexeme[0] == '-' || lexeme[0] == '.') && std::isdigit(lexeme[1])))
+		|| (lexeme.length() >= 2 && (lexeme[0] == '-' || lexeme[0] == '.') && std::isdigit(lexeme[1])))
 		return true && !(lexeme.back() == '.' && veryStrict);
 
-	return std::isdigit(lexeme[lexeme.front() == '-' || lexeme.front() == '.']) && (std::isdigit(lexeme.back()) || !veryStrict);
+	// a view is not null terminated, a lone sign must not read the character after it.
+	const size_t firstDigit = lexeme.front() == '-' || lexeme.front() == '.';
+	return firstDigit < lexeme.length() && std::isdigit(lexeme[firstDigit]) && (std::isdigit(lexeme.back()) || !veryStrict);
 }
 
 static std::string_view trimLeadingZeros(const std::string& str) {
@@ -81,19 +86,24 @@ void Parser::setBracketOperators(const std::vector<std::pair<Lexeme, Lexeme>>& b
 	for (const auto& [openBracket, closeBracket] : bracketPairs) {
 		mBracketsOperators.openBracketsOperators[openBracket] = closeBracket;
 		mBracketsOperators.closeBracketsOperators[closeBracket] = openBracket;
+		iUpdateBracketClasses(openBracket);
 	}
 }
 
 void Parser::setOperatorLevels(const std::vector<std::pair<Lexeme, OperatorLevel>>& operatorPairs) {
 	mIsParserReady = false;
-	for (const auto& [lexeme, level] : operatorPairs)
+	for (const auto& [lexeme, level] : operatorPairs) {
 		mOperatorLevels[lexeme] = level;
+		iUpdateLexemeClass(lexeme);
+	}
 }
 
 void Parser::setOperatorEvalType(const std::vector<std::pair<Lexeme, OperatorEvalType>>& operatorEvalTypePairs) {
 	mIsParserReady = false;
-	for (const auto& [lexeme, evalType] : operatorEvalTypePairs)
+	for (const auto& [lexeme, evalType] : operatorEvalTypePairs) {
 		mOperatorEvalTypes[lexeme] = evalType;
+		iUpdateLexemeClass(lexeme);
+	}
 }
 
 void Parser::addBracketOperator(const Lexeme& openBracket, const Lexeme& closeBracket)
@@ -101,88 +111,235 @@ void Parser::addBracketOperator(const Lexeme& openBracket, const Lexeme& closeBr
 	mIsParserReady = false;
 	mBracketsOperators.openBracketsOperators[openBracket] = closeBracket;
 	mBracketsOperators.closeBracketsOperators[closeBracket] = openBracket;
+	iUpdateBracketClasses(openBracket);
 }
 
 void Parser::addOperatorLevel(const Lexeme& operatorLexeme, OperatorLevel operatorLevel)
 {
 	mIsParserReady = false;
 	mOperatorLevels[operatorLexeme] = operatorLevel;
+	iUpdateLexemeClass(operatorLexeme);
 }
 
 void Parser::addOperatorEvalType(const Lexeme& operatorLexme, OperatorEvalType operatorEvalType)
 {
 	mIsParserReady = false;
 	mOperatorEvalTypes[operatorLexme] = operatorEvalType;
+	iUpdateLexemeClass(operatorLexme);
 }
 
 void Parser::setRawExpressionBracketEvalType(const std::vector<std::pair<Lexeme, NodeFactory::Node::NodeState>>& rawExpressionBracketEvalTypePairs)
 {
 	mIsParserReady = false;
-	for (const auto& [lexeme, evalType] : rawExpressionBracketEvalTypePairs)
+	for (const auto& [lexeme, evalType] : rawExpressionBracketEvalTypePairs) {
 		mRawExpressionBracketEvalTypes[lexeme] = evalType;
+		iUpdateBracketClasses(lexeme);
+	}
 }
 
 void Parser::addRawExpressionBracketEvalType(const Lexeme& openBracketLexeme, NodeFactory::Node::NodeState rawExpressionBracketEvalType)
 {
 	mIsParserReady = false;
 	mRawExpressionBracketEvalTypes[openBracketLexeme] = rawExpressionBracketEvalType;
+	iUpdateBracketClasses(openBracketLexeme);
+}
+
+void Parser::setOperatorTreeEngine(OperatorTreeEngine operatorTreeEngine) {
+	mOperatorTreeEngine = operatorTreeEngine;
+}
+
+void Parser::setParseThreads(size_t threadAmount) {
+	mParseThreads = std::max<size_t>(threadAmount, 1);
 }
 
-bool Parser::isOperator(const Lexeme& lexeme) const {
+bool Parser::isOperator(LexemeView lexeme) const {
 	return mOperatorEvalTypes.contains(lexeme) || mOperatorLevels.contains(lexeme);
 }
 
-Parser::OperatorEvalType Parser::getOperatorType(const Lexeme& oprLexeme) const {
-	return mOperatorEvalTypes.at(oprLexeme);
+Parser::OperatorEvalType Parser::getOperatorType(LexemeView oprLexeme) const {
+	return stringMapAt(mOperatorEvalTypes, oprLexeme);
 }
 
-Parser::OperatorLevel Parser::getOperatorLevel(const Lexeme& oprLexeme) const {
-	return mOperatorLevels.at(oprLexeme);
+Parser::OperatorLevel Parser::getOperatorLevel(LexemeView oprLexeme) const {
+	return stringMapAt(mOperatorLevels, oprLexeme);
 }
 
-std::vector<std::string> Parser::parseNumbers(const std::vector<Lexeme>& lexemes) const {
-	std::vector<std::string> result;
-	std::string numberBuffer{ "" };
-	bool foundDecimalPoint{ false };
-	bool foundMinusSign{ false };
+void Parser::iUpdateLexemeClass(const Lexeme& lexeme) {
+	LexemeClass& lexemeClass{ mLexemeClasses[lexeme] };
+
+	if (const auto evalTypeIt{ mOperatorEvalTypes.find(lexeme) }; evalTypeIt != mOperatorEvalTypes.end()) {
+		lexemeClass.HasEvalType = true;
+		lexemeClass.EvalType = evalTypeIt->second;
+	}
+	if (const auto levelIt{ mOperatorLevels.find(lexeme) }; levelIt != mOperatorLevels.end()) {
+		lexemeClass.HasLevel = true;
+		lexemeClass.Level = levelIt->second;
+	}
+	lexemeClass.IsOpenBracket = mBracketsOperators.openBracketsOperators.contains(lexeme);
+	lexemeClass.IsCloseBracket = mBracketsOperators.closeBracketsOperators.contains(lexeme);
+
+	// both brackets of a pair are classed by the open one.
+	const Lexeme* openBracket{ nullptr };
+	if (lexemeClass.IsOpenBracket)
+		openBracket = &lexeme;
+	else if (lexemeClass.IsCloseBracket)
+		openBracket = &mBracketsOperators.closeBracketsOperators.find(lexeme)->second;
+
+	lexemeClass.BracketId = 0;
+	lexemeClass.IsRawExpressionBracket = false;
+	if (openBracket) {
+		lexemeClass.BracketId = mBracketIds.try_emplace(*openBracket, static_cast<uint32_t>(mBracketIds.size() + 1)).first->second;
+		if (const auto rawTypeIt{ mRawExpressionBracketEvalTypes.find(*openBracket) }; rawTypeIt != mRawExpressionBracketEvalTypes.end()) {
+			lexemeClass.IsRawExpressionBracket = true;
+			lexemeClass.RawExpressionType = rawTypeIt->second;
+		}
+	}
+
+	if (lexeme.size() == 1)
+		mByteLexemeClasses[static_cast<unsigned char>(lexeme[0])] = lexemeClass;
+	if (!lexeme.empty() && std::isdigit(lexeme[0]))
+		mDigitLexemeClasses = true;
+}
+
+void Parser::iUpdateBracketClasses(const Lexeme& openBracket) {
+	const auto closeBracketIt{ mBracketsOperators.openBracketsOperators.find(openBracket) };
+	if (closeBracketIt == mBracketsOperators.openBracketsOperators.end())
+		return;
+
+	iUpdateLexemeClass(openBracket);
+	iUpdateLexemeClass(closeBracketIt->second);
+}
+
+Parser::LexemeClass Parser::iLexemeClass(LexemeView lexeme, const KeywordOverlay* parameters) const {
+	LexemeClass lexemeClass;
+	bool foundLexemeClass{ false };
+
+	if (lexeme.size() == 1) {
+		if (const std::optional<LexemeClass>& byteLexemeClass{ mByteLexemeClasses[static_cast<unsigned char>(lexeme[0])] }) {
+			lexemeClass = *byteLexemeClass;
+			foundLexemeClass = true;
+		}
+	}
+	// a lexeme that starts with a digit is a number, no operator or bracket is spelled like one.
+	else if (mDigitLexemeClasses || lexeme.empty() || !std::isdigit(lexeme[0])) {
+		if (const auto lexemeClassIt{ mLexemeClasses.find(lexeme) }; lexemeClassIt != mLexemeClasses.end()) {
+			lexemeClass = lexemeClassIt->second;
+			foundLexemeClass = true;
+		}
+	}
+
+	// no parameter is named like an operator or a bracket (checkIfValidParameterName), the layers don't overlap.
+	if (!foundLexemeClass && parameters && parameters->contains(lexeme)) {
+		lexemeClass.EvalType = OperatorEvalType::Constant;
+		lexemeClass.HasEvalType = true;
+		lexemeClass.Level = ParameterLevel;
+		lexemeClass.HasLevel = true;
+	}
+
+	lexemeClass.IsNumber = strictedIsNumber(lexeme);
+	lexemeClass.IsOperand = lexemeClass.IsNumber || lexemeClass.is(OperatorEvalType::Constant);
+	return lexemeClass;
+}
+
+Parser::NumberMerger::NumberMerger(const Parser& parser, const KeywordOverlay* parameters) : mParser{ &parser }, mParameters{ parameters } {
+	mNumberBuffer.reserve(50);
+}
+
+void Parser::NumberMerger::iEmit(LexemeView lexeme, ParsedLexemes& result) {
+	const LexemeClass lexemeClass{ mParser->iLexemeClass(lexeme, mParameters) };
+	result.Lexemes.push_back(lexeme);
+	result.Classes.push_back(lexemeClass);
+	mHasResult = true;
+	mLastAllowsSign = lexemeClass.is(OperatorEvalType::Infix) || lexemeClass.is(OperatorEvalType::Postfix) || lexemeClass.IsOpenBracket;
+}
+
+void Parser::NumberMerger::iOwnBuffer() {
+	if (mBufferOwned)
+		return;
+	mNumberBuffer.assign(mBuffered);
+	mBuffered = mNumberBuffer;
+	mBufferOwned = true;
+}
 
-	numberBuffer.reserve(50);
-	result.reserve(50);
+void Parser::NumberMerger::feed(const std::vector<LexemeView>& lexemes, bool sharedContent, bool lastBatch, ParsedLexemes& result) {
+	// a buffer of one lexeme, or of lexemes of the same content with nothing between them, stays a view.
+	auto bufferedLexeme = [&]() -> LexemeView {
+		return mBufferOwned ? LexemeView(result.Joined.emplace_back(mNumberBuffer)) : mBuffered;
+		};
+
+	auto clearBuffer = [&]() {
+		mBuffered = LexemeView();
+		mNumberBuffer.clear();
+		mBufferOwned = false;
+		};
 
-	for (const std::string& lexeme : lexemes) {
-		if ((isNumber(numberBuffer) || numberBuffer.empty()) && lexeme == "." && !foundDecimalPoint)
-			foundDecimalPoint = true;
+	for (const LexemeView lexeme : lexemes) {
+		if ((isNumber(mBuffered) || mBuffered.empty()) && lexeme == "." && !mFoundDecimalPoint)
+			mFoundDecimalPoint = true;
 
-		else if (result.empty() && numberBuffer.empty() && lexeme == "-" && !foundMinusSign)
-			foundMinusSign = true;
+		else if (!mHasResult && mBuffered.empty() && lexeme == "-" && !mFoundMinusSign)
+			mFoundMinusSign = true;
 
 		// gg debug this code [fucked up counter = 2]
-		else if (!numberBuffer.empty() &&
-			((lexeme == "." && foundDecimalPoint) ||
-				(lexeme == "-" && foundMinusSign) ||
-				(!(!result.empty() &&
-					((mOperatorEvalTypes.contains(result.back()) &&
-						(mOperatorEvalTypes.at(result.back()) == OperatorEvalType::Infix ||
-							mOperatorEvalTypes.at(result.back()) == OperatorEvalType::Postfix)) ||
-						mBracketsOperators.openBracketsOperators.contains(result.back())) ||
-					result.empty())) ||
-				(std::isdigit(lexeme[0]) && strictedIsNumber(numberBuffer, true)) || // curr is a number, buffer is a "number"
-				(std::isdigit(lexeme[0]) && !isNumber(numberBuffer)) || // curr is a number, buffer is not a number
-				(!std::isdigit(lexeme[0]) && isNumber(numberBuffer)) || // curr is not a number, buffer is a number
-				(!std::isdigit(lexeme[0]) && !isNumber(numberBuffer)))) { // curr is not a number, buffer is not a number
-			result.push_back(numberBuffer);
-			foundMinusSign = (lexeme == "-");
-			foundDecimalPoint = (lexeme == ".");
-			numberBuffer.clear();
+		else if (!mBuffered.empty() &&
+			((lexeme == "." && mFoundDecimalPoint) ||
+				(lexeme == "-" && mFoundMinusSign) ||
+				(mHasResult && !mLastAllowsSign) ||
+				(std::isdigit(lexeme[0]) && strictedIsNumber(mBuffered, true)) || // curr is a number, buffer is a "number"
+				(std::isdigit(lexeme[0]) && !isNumber(mBuffered)) || // curr is a number, buffer is not a number
+				(!std::isdigit(lexeme[0]) && isNumber(mBuffered)) || // curr is not a number, buffer is a number
+				(!std::isdigit(lexeme[0]) && !isNumber(mBuffered)))) { // curr is not a number, buffer is not a number
+			iEmit(bufferedLexeme(), result);
+			mFoundMinusSign = (lexeme == "-");
+			mFoundDecimalPoint = (lexeme == ".");
+			clearBuffer();
 		}
 
-		numberBuffer += lexeme;
+		if (mBuffered.empty())
+			mBuffered = lexeme;
+		else if (!mBufferOwned && sharedContent && mBuffered.data() + mBuffered.size() == lexeme.data())
+			mBuffered = LexemeView(mBuffered.data(), mBuffered.size() + lexeme.size());
+		else {
+			iOwnBuffer();
+			mNumberBuffer += lexeme;
+			mBuffered = mNumberBuffer;
+		}
+	}
+
+	if (mBuffered.empty())
+		return;
+	if (lastBatch) {
+		iEmit(bufferedLexeme(), result);
+		clearBuffer();
 	}
+	else
+		iOwnBuffer(); // the lexemes of this batch are gone by the next one.
+}
+
+ParsedLexemes Parser::parseNumbers(std::string_view content, const std::vector<Token>& tokens, std::span<const RawStringSpan> rawStrings) const {
+	return iParseNumbers(content, tokens, rawStrings, nullptr);
+}
+
+ParsedLexemes Parser::iParseNumbers(std::string_view content, const std::vector<Token>& tokens, std::span<const RawStringSpan> rawStrings, const KeywordOverlay* parameters) const {
+	ParsedLexemes parsedLexemes;
+	parsedLexemes.Content = content;
+	parsedLexemes.RawStrings = rawStrings;
 
-	if (!numberBuffer.empty())
-		result.push_back(numberBuffer);
+	std::vector<LexemeView> lexemes;
+	lexemes.reserve(tokens.size());
+	for (const Token& token : tokens)
+		lexemes.emplace_back(token.text(content));
 
-	return result;
+	parsedLexemes.Lexemes.reserve(lexemes.size());
+	parsedLexemes.Classes.reserve(lexemes.size());
+	NumberMerger{ *this, parameters }.feed(lexemes, true, true, parsedLexemes);
+	return parsedLexemes;
+}
+
+std::vector<std::string> Parser::parseNumbers(const std::vector<Lexeme>& lexemes) const {
+	ParsedLexemes parsedLexemes;
+	NumberMerger{ *this }.feed(std::vector<LexemeView>(lexemes.begin(), lexemes.end()), false, true, parsedLexemes);
+	return std::vector<std::string>(parsedLexemes.Lexemes.begin(), parsedLexemes.Lexemes.end());
 }
 
 std::optional<RuntimeError<ParserNotReadyError>> Parser::parserReady() {
@@ -223,235 +380,764 @@ static Result<T> topPopNotEmpty(std::stack<T>& stk) {
 	return temp;
 }
 
-Result<std::vector<NodeFactory::NodePos>> Parser::createOperatorTree(const std::vector<Lexeme>& parsedLexemes, const std::unordered_map<Parser::Lexeme, Lambda>& EvaluatorLambdaFunction) const {
-	if (!mIsParserReady)
-		return RuntimeError<ParserNotReadyError>("Please run parserReady() first!, To make sure that parser is ready.");
+// the raw strings of content nested in rawExpression (a lexeme of content), when the lexer listed them.
+// raw expressions are asked for in the order they were written, nextRawString skips the ones passed already.
+static std::span<const RawStringSpan> nestedRawStrings(std::string_view content, std::span<const RawStringSpan> rawStrings, size_t& nextRawString, std::string_view rawExpression) {
+	const std::less<const char*> before;
+	if (rawStrings.empty() || before(rawExpression.data(), content.data()) || !before(rawExpression.data(), content.data() + content.size()))
+		return {};
 
-	std::stack<NodeFactory::NodePos> resultStack;
-	std::stack<Lexeme> operatorStack;
-	std::unordered_map<NodeFactory::NodePos, RuntimeType> specialTypes;
+	const size_t offset{ static_cast<size_t>(rawExpression.data() - content.data()) };
+	while (nextRawString < rawStrings.size() && rawStrings[nextRawString].Offset < offset)
+		nextRawString += rawStrings[nextRawString].NestedCount + 1;
 
-	const auto checkOperatorEvalTypeState = [this](const Lexeme& lexeme, OperatorEvalType checkState) {
-		return (mOperatorEvalTypes.contains(lexeme) && (mOperatorEvalTypes.at(lexeme) == checkState));
-		};
+	if (nextRawString >= rawStrings.size() || rawStrings[nextRawString].Offset != offset || rawStrings[nextRawString].Length != rawExpression.size())
+		return {};
+	return rawStrings.subspan(nextRawString + 1, rawStrings[nextRawString].NestedCount);
+}
 
-	for (auto it = parsedLexemes.begin(); it != parsedLexemes.end(); it++) {
-		const Parser::Lexeme parsedLexeme = *it;
+// a lambda written right before a raw expression of its parameters' type is applied to it while parsing.
+// a storage of one element is taken for the element.
+static bool isLambdaApplication(const std::unordered_map<NodeFactory::NodePos, RuntimeType>& specialTypes, NodeFactory::NodePos lambdaNode, const RuntimeType& argumentType) {
+	const auto lambdaTypeIt{ specialTypes.find(lambdaNode) };
+	if (lambdaTypeIt == specialTypes.end() || NodeFactory::node(lambdaNode).nodestate != NodeFactory::Node::NodeState::LambdaFuntion)
+		return false;
 
-		// if is a operand or a constant
-		if ((strictedIsNumber(parsedLexeme) || checkOperatorEvalTypeState(parsedLexeme, OperatorEvalType::Constant)) &&
-			(it == parsedLexemes.begin() || (!strictedIsNumber(*std::prev(it)) && !checkOperatorEvalTypeState(*std::prev(it), OperatorEvalType::Constant)))) {
-			NodeFactory::NodePos temp{ NodeFactory::create(parsedLexeme) };
-			if (checkOperatorEvalTypeState(parsedLexeme, OperatorEvalType::Constant))
-				NodeFactory::node(temp).nodestate = NodeFactory::Node::NodeState::Operator;
+	const RuntimeType& parametersType{ RuntimeCompoundType::_getLambdaParamsType(std::get<RuntimeCompoundType>(lambdaTypeIt->second)) };
+	if (const RuntimeCompoundType* argumentCompoundType{ std::get_if<RuntimeCompoundType>(&argumentType) };
+		argumentCompoundType && argumentCompoundType->Type == RuntimeBaseType::_Storage && argumentCompoundType->getChildren().size() == 1)
+		return parametersType == argumentCompoundType->getChildren()[0];
+	return parametersType == argumentType;
+}
+
+Result<NodeFactory::NodePos, std::runtime_error> Parser::iApplyLambda(std::unordered_map<NodeFactory::NodePos, RuntimeType>& specialTypes, NodeFactory::NodePos lambdaNode, NodeFactory::NodePos argumentNode, const std::unordered_map<Parser::Lexeme, Lambda>& EvaluatorLambdaFunction) {
+	Result<Lambda::LambdaArguments, std::runtime_error> evaluatedResult{ Lambda::_NodeExpressionsEvaluator({ lambdaNode, argumentNode }, EvaluatorLambdaFunction) };
+	EXCEPT_RETURN(evaluatedResult);
 
-			resultStack.push(temp);
+	const NodeFactory::NodePos evaluateNodePos{ evaluatedResult.getValue()[0].toNodeExpression() };
+	specialTypes[evaluateNodePos] = evaluatedResult.getValue()[0].getDetailTypeHold();
+	return evaluateNodePos;
+}
 
-			// if is a argument of postfix operator
-			while (!operatorStack.empty() && checkOperatorEvalTypeState(operatorStack.top(), OperatorEvalType::Postfix))
-			{
-				auto operatorNode = NodeFactory::create(topPopNotEmpty(operatorStack).getValue()); // guarantee that operatorNodeValue will always contains a value.
-				auto prefixOperandNodeValue = topPopNotEmpty(resultStack);
-				EXCEPT_RETURN(prefixOperandNodeValue);
+Parser::OperatorTreeBuilder::OperatorTreeBuilder(const Parser& parser, const std::unordered_map<Parser::Lexeme, Lambda>& EvaluatorLambdaFunction, bool copyLexemes, const KeywordOverlay* parameters) :
+	mParser{ &parser }, mParameters{ parameters }, mEvaluatorLambdaFunction{ &EvaluatorLambdaFunction }, mCopyLexemes{ copyLexemes } {
+	if (!parser.mIsParserReady)
+		mError = RuntimeError<ParserNotReadyError>("Please run parserReady() first!, To make sure that parser is ready.");
+}
 
-				NodeFactory::node(operatorNode).nodestate = NodeFactory::Node::NodeState::Operator;
-				NodeFactory::node(operatorNode).rightPos = prefixOperandNodeValue.getValue();
-				resultStack.push(operatorNode);
-			}
-		}
+Parser::LexemeView Parser::OperatorTreeBuilder::iKeep(LexemeView lexeme) {
+	if (!mCopyLexemes)
+		return lexeme;
 
-		// if stack is empty, if is open bracket, if top stack is open bracket
-		else if (!strictedIsNumber(parsedLexeme) && !checkOperatorEvalTypeState(parsedLexeme, OperatorEvalType::Constant) &&
-			!mBracketsOperators.closeBracketsOperators.contains(parsedLexeme) &&
-			!(checkOperatorEvalTypeState(parsedLexeme, OperatorEvalType::Prefix) && !resultStack.empty()) &&
-			!(checkOperatorEvalTypeState(parsedLexeme, OperatorEvalType::Postfix)) &&
-			(operatorStack.empty() ||
-				mBracketsOperators.openBracketsOperators.contains(parsedLexeme) ||
-				mBracketsOperators.openBracketsOperators.contains(operatorStack.top())))
-			operatorStack.push(parsedLexeme);
+	if (const auto evalTypeIt{ mParser->mOperatorEvalTypes.find(lexeme) }; evalTypeIt != mParser->mOperatorEvalTypes.end())
+		return evalTypeIt->first;
+	if (const auto bracketIt{ mParser->mBracketsOperators.openBracketsOperators.find(lexeme) }; bracketIt != mParser->mBracketsOperators.openBracketsOperators.end())
+		return bracketIt->first;
 
-		// if postfix operator, ignore
-		else if (checkOperatorEvalTypeState(parsedLexeme, OperatorEvalType::Postfix)) {
-			operatorStack.push(parsedLexeme);
-			continue;
-		}
+	// copies above the stack position being pushed to were popped already.
+	const size_t depth{ mOperatorStack.size() };
+	while (!mOwnedDepths.empty() && mOwnedDepths.back() >= depth) {
+		mOwnedDepths.pop_back();
+		mOwnedLexemes.pop_back();
+	}
+	mOwnedDepths.push_back(depth);
+	return mOwnedLexemes.emplace_back(lexeme);
+}
+
+void Parser::OperatorTreeBuilder::setRawStrings(std::string_view content, std::span<const RawStringSpan> rawStrings) {
+	mContent = content;
+	mRawStrings = rawStrings;
+	mNextRawString = 0;
+}
+
+void Parser::OperatorTreeBuilder::push(LexemeView parsedLexeme, const LexemeClass& lexemeClass) {
+	if (mError || mReturnsEmpty)
+		return;
+
+	mError = iPush(parsedLexeme, lexemeClass);
+	mPreviousIsOperand = lexemeClass.IsOperand;
+}
+
+std::optional<std::exception> Parser::OperatorTreeBuilder::iPush(LexemeView parsedLexeme, const LexemeClass& lexemeClass) {
+	// if is a operand or a constant
+	if (lexemeClass.IsOperand && !mPreviousIsOperand) {
+		NodeFactory::NodePos temp{ NodeFactory::create(parsedLexeme) };
+		if (lexemeClass.is(OperatorEvalType::Constant))
+			NodeFactory::node(temp).nodestate = NodeFactory::Node::NodeState::Operator;
 
-		// if is a prefix operator
-		else if (checkOperatorEvalTypeState(parsedLexeme, OperatorEvalType::Prefix) && !resultStack.empty()) {
-			auto operatorNode = NodeFactory::create(parsedLexeme);
-			auto prefixOperandNode = topPopNotEmpty(resultStack);
-			EXCEPT_RETURN(prefixOperandNode);
+		mResultStack.push(temp);
+
+		// if is a argument of postfix operator
+		while (!mOperatorStack.empty() && mOperatorStack.top().Class.is(OperatorEvalType::Postfix))
+		{
+			auto operatorNode = NodeFactory::create(topPopNotEmpty(mOperatorStack).getValue().Text); // guarantee that operatorNodeValue will always contains a value.
+			auto prefixOperandNodeValue = topPopNotEmpty(mResultStack);
+			EXCEPT_RETURN(prefixOperandNodeValue);
 
-			NodeFactory::node(operatorNode).leftPos = prefixOperandNode.getValue();
 			NodeFactory::node(operatorNode).nodestate = NodeFactory::Node::NodeState::Operator;
-			resultStack.push(operatorNode);
+			NodeFactory::node(operatorNode).rightPos = prefixOperandNodeValue.getValue();
+			mResultStack.push(operatorNode);
 		}
+	}
 
-		// if found close bracket
-		else if (mBracketsOperators.closeBracketsOperators.contains(parsedLexeme)) {
-			Lexeme openBracket{ mBracketsOperators.closeBracketsOperators.at(parsedLexeme) };
+	// if stack is empty, if is open bracket, if top stack is open bracket
+	else if (!lexemeClass.IsOperand &&
+		!lexemeClass.IsCloseBracket &&
+		!(lexemeClass.is(OperatorEvalType::Prefix) && !mResultStack.empty()) &&
+		!(lexemeClass.is(OperatorEvalType::Postfix)) &&
+		(mOperatorStack.empty() ||
+			lexemeClass.IsOpenBracket ||
+			mOperatorStack.top().Class.IsOpenBracket))
+		mOperatorStack.push(StackedOperator{ iKeep(parsedLexeme), lexemeClass });
+
+	// if postfix operator, ignore
+	else if (lexemeClass.is(OperatorEvalType::Postfix)) {
+		mOperatorStack.push(StackedOperator{ iKeep(parsedLexeme), lexemeClass });
+	}
 
-			if (mRawExpressionBracketEvalTypes.contains(openBracket)) {
-				Lexeme operatorNodeValue;
-				if (const auto prevIt{ *std::prev(it) }; strictedIsNumber(prevIt) || (mOperatorEvalTypes.contains(prevIt) && mOperatorEvalTypes.at(prevIt) == OperatorEvalType::Constant)) {
-					auto operatorNodeRawValue = topPopNotEmpty(resultStack);
-					EXCEPT_RETURN(operatorNodeRawValue);
-					operatorNodeValue = NodeFactory::node(operatorNodeRawValue.getValue()).value;
-				}
-				else {
-					auto operatorNodeRawValue = topPopNotEmpty(operatorStack);
-					EXCEPT_RETURN(operatorNodeRawValue);
-					operatorNodeValue = operatorNodeRawValue.getValue();
-
-					if (operatorNodeValue == openBracket) { // empty bracket case
-						operatorNodeValue = "";
-						operatorStack.emplace(openBracket);
-					}
-				}
+	// if is a prefix operator
+	else if (lexemeClass.is(OperatorEvalType::Prefix) && !mResultStack.empty()) {
+		auto operatorNode = NodeFactory::create(parsedLexeme);
+		auto prefixOperandNode = topPopNotEmpty(mResultStack);
+		EXCEPT_RETURN(prefixOperandNode);
 
-				auto operatorNode = (mRawExpressionBracketEvalTypes.at(openBracket) == NodeFactory::Node::NodeState::LambdaFuntion ||
-					mRawExpressionBracketEvalTypes.at(openBracket) == NodeFactory::Node::NodeState::Storage) ?
-					createRawExpressionOperatorTree(operatorNodeValue, mRawExpressionBracketEvalTypes.at(openBracket), EvaluatorLambdaFunction) :
-					NodeFactory::create(operatorNodeValue);
-				EXCEPT_RETURN(operatorNode);
-
-				Result<RuntimeType, std::runtime_error> operatorNodeReturnTypeResult{ getReturnType(operatorNode.getValue(), EvaluatorLambdaFunction) };
-				EXCEPT_RETURN(operatorNodeReturnTypeResult);
-
-				RuntimeType operatorNodeReturnType{ operatorNodeReturnTypeResult.moveValue() };
-
-				if (resultStack.size() && specialTypes.contains(resultStack.top()) &&
-					NodeFactory::node(resultStack.top()).nodestate == NodeFactory::Node::NodeState::LambdaFuntion &&
-					RuntimeCompoundType::_getLambdaParamsType(std::get<RuntimeCompoundType>(specialTypes.at(resultStack.top()))) == (
-						std::holds_alternative<RuntimeCompoundType>(operatorNodeReturnType) ? ((
-							std::get<RuntimeCompoundType>(operatorNodeReturnType).Type == RuntimeBaseType::_Storage &&
-							std::get<RuntimeCompoundType>(operatorNodeReturnType).Children.size() == 1)
-						? std::get<RuntimeCompoundType>(operatorNodeReturnType).Children[0]
-						: std::get<RuntimeCompoundType>(operatorNodeReturnType)) : operatorNodeReturnType)) 
-				{
-					Result<Lambda::LambdaArguments, std::runtime_error> evaluatedResult{
-						Lambda::_NodeExpressionsEvaluator({resultStack.top(), operatorNode.getValue()}, EvaluatorLambdaFunction)
-					};
-					EXCEPT_RETURN(evaluatedResult);
-
-					NodeFactory::NodePos evaluateNodePos{ evaluatedResult.getValue()[0].toNodeExpression() };
-					specialTypes[evaluateNodePos] = evaluatedResult.getValue()[0].getDetailTypeHold();
-					resultStack.pop();
-					resultStack.push(evaluateNodePos);
-				}
+		NodeFactory::node(operatorNode).leftPos = prefixOperandNode.getValue();
+		NodeFactory::node(operatorNode).nodestate = NodeFactory::Node::NodeState::Operator;
+		mResultStack.push(operatorNode);
+	}
 
-				else {
-					specialTypes[operatorNode.getValue()] = std::move(operatorNodeReturnType);
-					resultStack.push(operatorNode.getValue());
+	// if found close bracket
+	else if (lexemeClass.IsCloseBracket) {
+		const LexemeView openBracket{ stringMapAt(mParser->mBracketsOperators.closeBracketsOperators, parsedLexeme) };
+
+		if (mParser->mRawExpressionBracketEvalTypes.contains(openBracket)) {
+			Lexeme operatorNodeValue; // owned, creating nodes can move the interned text a view would point at.
+			std::span<const RawStringSpan> nestedRawStrings;
+			if (mPreviousIsOperand) {
+				auto operatorNodeRawValue = topPopNotEmpty(mResultStack);
+				EXCEPT_RETURN(operatorNodeRawValue);
+				operatorNodeValue = NodeFactory::node(operatorNodeRawValue.getValue()).value();
+			}
+			else {
+				auto operatorNodeRawValue = topPopNotEmpty(mOperatorStack);
+				EXCEPT_RETURN(operatorNodeRawValue);
+				operatorNodeValue = operatorNodeRawValue.getValue().Text;
+				nestedRawStrings = ::nestedRawStrings(mContent, mRawStrings, mNextRawString, operatorNodeRawValue.getValue().Text);
+
+				if (operatorNodeValue == openBracket) { // empty bracket case
+					operatorNodeValue = "";
+					mOperatorStack.push(StackedOperator{ openBracket, operatorNodeRawValue.getValue().Class });
 				}
 			}
 
-			while (!operatorStack.empty() && operatorStack.top() != openBracket) {
-				auto operatorNodeValue = topPopNotEmpty(operatorStack);
-				auto operandNode2 = topPopNotEmpty(resultStack);
-				auto operandNode1 = topPopNotEmpty(resultStack);
+			const NodeFactory::Node::NodeState rawExpressionType{ stringMapAt(mParser->mRawExpressionBracketEvalTypes, openBracket) };
+			auto operatorNode = (rawExpressionType == NodeFactory::Node::NodeState::LambdaFuntion ||
+				rawExpressionType == NodeFactory::Node::NodeState::Storage) ?
+				mParser->createRawExpressionOperatorTree(operatorNodeValue, rawExpressionType, *mEvaluatorLambdaFunction, nestedRawStrings, mParameters) :
+				NodeFactory::create(operatorNodeValue);
+			EXCEPT_RETURN(operatorNode);
 
-				EXCEPT_RETURN(operandNode1);
-				EXCEPT_RETURN(operandNode2);
-				EXCEPT_RETURN(operatorNodeValue);
+			Result<RuntimeType, std::runtime_error> operatorNodeReturnTypeResult{ getReturnType(operatorNode.getValue(), *mEvaluatorLambdaFunction) };
+			EXCEPT_RETURN(operatorNodeReturnTypeResult);
 
-				auto operatorNode = NodeFactory::create(operatorNodeValue.getValue());
-				NodeFactory::node(operatorNode).nodestate = NodeFactory::Node::NodeState::Operator;
+			RuntimeType operatorNodeReturnType{ operatorNodeReturnTypeResult.moveValue() };
 
-				processNode(operatorNode, operandNode1.getValue(), operandNode2.getValue());
+			if (mResultStack.size() && isLambdaApplication(mSpecialTypes, mResultStack.top(), operatorNodeReturnType)) {
+				Result<NodeFactory::NodePos, std::runtime_error> evaluateNodePos{ iApplyLambda(mSpecialTypes, mResultStack.top(), operatorNode.getValue(), *mEvaluatorLambdaFunction) };
+				EXCEPT_RETURN(evaluateNodePos);
 
-				resultStack.push(operatorNode);
+				mResultStack.pop();
+				mResultStack.push(evaluateNodePos.getValue());
 			}
 
-			if (operatorStack.empty())
-				return RuntimeError<ParserSyntaxError>("bracket closed before one open.");
-			operatorStack.pop(); // error here
+			else {
+				mSpecialTypes[operatorNode.getValue()] = std::move(operatorNodeReturnType);
+				mResultStack.push(operatorNode.getValue());
+			}
+		}
 
-			if (resultStack.empty())
-				return std::vector<NodeFactory::NodePos>{}; // return null
+		while (!mOperatorStack.empty() && mOperatorStack.top().Text != openBracket) {
+			auto operatorNodeValue = topPopNotEmpty(mOperatorStack);
+			auto operandNode2 = topPopNotEmpty(mResultStack);
+			auto operandNode1 = topPopNotEmpty(mResultStack);
 
-			// if current expression is argument of postfix operator
-			while (!operatorStack.empty() && checkOperatorEvalTypeState(operatorStack.top(), OperatorEvalType::Postfix)) {
-				auto operatorNode = NodeFactory::create(topPopNotEmpty(operatorStack).getValue()); // guarantee that operatorNodeValue will always contains a value.
-				auto prefixOperandNodeValue = topPopNotEmpty(resultStack);
-				EXCEPT_RETURN(prefixOperandNodeValue);
+			EXCEPT_RETURN(operandNode1);
+			EXCEPT_RETURN(operandNode2);
+			EXCEPT_RETURN(operatorNodeValue);
 
-				NodeFactory::node(operatorNode).nodestate = NodeFactory::Node::NodeState::Operator;
-				NodeFactory::node(operatorNode).rightPos = prefixOperandNodeValue.getValue();
-				resultStack.push(operatorNode);
-			}
+			auto operatorNode = NodeFactory::create(operatorNodeValue.getValue().Text);
+			NodeFactory::node(operatorNode).nodestate = NodeFactory::Node::NodeState::Operator;
+
+			processNode(operatorNode, operandNode1.getValue(), operandNode2.getValue());
+
+			mResultStack.push(operatorNode);
 		}
 
-		// if current operator level is higher than top stack
-		else if (!checkOperatorEvalTypeState(parsedLexeme, OperatorEvalType::Constant) && mOperatorLevels.contains(parsedLexeme) && mOperatorLevels.contains(operatorStack.top()) &&
-			mOperatorLevels.at(parsedLexeme) > mOperatorLevels.at(operatorStack.top()))
-			operatorStack.push(parsedLexeme);
+		if (mOperatorStack.empty())
+			return RuntimeError<ParserSyntaxError>("bracket closed before one open.");
+		mOperatorStack.pop(); // error here
 
-		// if current operator level is lesser than top stack or both current lexeme and last lexeme is a number
-		else if (((strictedIsNumber(parsedLexeme) || checkOperatorEvalTypeState(parsedLexeme, OperatorEvalType::Constant)) &&
-			(strictedIsNumber(*std::prev(it)) || checkOperatorEvalTypeState(*std::prev(it), OperatorEvalType::Constant))) ||
-			(mOperatorLevels.contains(parsedLexeme) && mOperatorLevels.contains(operatorStack.top()) &&
-				mOperatorLevels.at(parsedLexeme) <= mOperatorLevels.at(operatorStack.top()))) {
-			size_t currLexemeOperatorLevels{ strictedIsNumber(parsedLexeme) ? 0 : mOperatorLevels.at(parsedLexeme) };
-			while (!operatorStack.empty() && mOperatorLevels.contains(operatorStack.top()) && (currLexemeOperatorLevels <= mOperatorLevels.at(operatorStack.top()))) {
-				auto operatorNodeValue = topPopNotEmpty(operatorStack);
-				auto operandNode2 = topPopNotEmpty(resultStack);
-				auto operandNode1 = topPopNotEmpty(resultStack);
+		if (mResultStack.empty()) {
+			mReturnsEmpty = true;
+			return std::nullopt;
+		}
 
-				EXCEPT_RETURN(operandNode1);
-				EXCEPT_RETURN(operandNode2);
-				EXCEPT_RETURN(operatorNodeValue);
+		// if current expression is argument of postfix operator
+		while (!mOperatorStack.empty() && mOperatorStack.top().Class.is(OperatorEvalType::Postfix)) {
+			auto operatorNode = NodeFactory::create(topPopNotEmpty(mOperatorStack).getValue().Text); // guarantee that operatorNodeValue will always contains a value.
+			auto prefixOperandNodeValue = topPopNotEmpty(mResultStack);
+			EXCEPT_RETURN(prefixOperandNodeValue);
 
-				auto operatorNode = NodeFactory::create(operatorNodeValue.getValue());
-				processNode(operatorNode, operandNode1.getValue(), operandNode2.getValue());
-				NodeFactory::node(operatorNode).nodestate = NodeFactory::Node::NodeState::Operator;
+			NodeFactory::node(operatorNode).nodestate = NodeFactory::Node::NodeState::Operator;
+			NodeFactory::node(operatorNode).rightPos = prefixOperandNodeValue.getValue();
+			mResultStack.push(operatorNode);
+		}
+	}
 
-				resultStack.push(operatorNode);
-			}
+	// if current operator level is higher than top stack
+	else if (!lexemeClass.is(OperatorEvalType::Constant) && lexemeClass.HasLevel && !mOperatorStack.empty() && mOperatorStack.top().Class.HasLevel &&
+		lexemeClass.Level > mOperatorStack.top().Class.Level)
+		mOperatorStack.push(StackedOperator{ iKeep(parsedLexeme), lexemeClass });
+
+	// if current operator level is lesser than top stack or both current lexeme and last lexeme is a number
+	else if ((lexemeClass.IsOperand && mPreviousIsOperand) ||
+		(lexemeClass.HasLevel && !mOperatorStack.empty() && mOperatorStack.top().Class.HasLevel &&
+			lexemeClass.Level <= mOperatorStack.top().Class.Level)) {
+		size_t currLexemeOperatorLevels{ lexemeClass.IsNumber ? 0 : lexemeClass.Level };
+		while (!mOperatorStack.empty() && mOperatorStack.top().Class.HasLevel && (currLexemeOperatorLevels <= mOperatorStack.top().Class.Level)) {
+			auto operatorNodeValue = topPopNotEmpty(mOperatorStack);
+			auto operandNode2 = topPopNotEmpty(mResultStack);
+			auto operandNode1 = topPopNotEmpty(mResultStack);
+
+			EXCEPT_RETURN(operandNode1);
+			EXCEPT_RETURN(operandNode2);
+			EXCEPT_RETURN(operatorNodeValue);
+
+			auto operatorNode = NodeFactory::create(operatorNodeValue.getValue().Text);
+			processNode(operatorNode, operandNode1.getValue(), operandNode2.getValue());
+			NodeFactory::node(operatorNode).nodestate = NodeFactory::Node::NodeState::Operator;
 
-			if (strictedIsNumber(parsedLexeme))
-				resultStack.push(NodeFactory::create(parsedLexeme));
-			else if (checkOperatorEvalTypeState(parsedLexeme, OperatorEvalType::Constant)) {
-				NodeFactory::NodePos temp{ NodeFactory::create(parsedLexeme) };
-				NodeFactory::node(temp).nodestate = NodeFactory::Node::NodeState::Operator;
-				resultStack.push(temp);
-			}
-			else
-				operatorStack.push(parsedLexeme);
+			mResultStack.push(operatorNode);
 		}
 
+		if (lexemeClass.IsNumber)
+			mResultStack.push(NodeFactory::create(parsedLexeme));
+		else if (lexemeClass.is(OperatorEvalType::Constant)) {
+			NodeFactory::NodePos temp{ NodeFactory::create(parsedLexeme) };
+			NodeFactory::node(temp).nodestate = NodeFactory::Node::NodeState::Operator;
+			mResultStack.push(temp);
+		}
 		else
-			return RuntimeError<ParserSyntaxError>("Check if bracket is closed, or operator argument is valid.");
+			mOperatorStack.push(StackedOperator{ iKeep(parsedLexeme), lexemeClass });
 	}
 
-	while (!operatorStack.empty()) {
-		auto operatorNodeValue = topPopNotEmpty(operatorStack);
-		auto operandNode2 = topPopNotEmpty(resultStack);
-		auto operandNode1 = topPopNotEmpty(resultStack);
+	else
+		return RuntimeError<ParserSyntaxError>("Check if bracket is closed, or operator argument is valid.");
+
+	return std::nullopt;
+}
+
+Result<std::vector<NodeFactory::NodePos>> Parser::OperatorTreeBuilder::finish() {
+	if (mError)
+		return *mError;
+	if (mReturnsEmpty)
+		return std::vector<NodeFactory::NodePos>{}; // return null
+
+	while (!mOperatorStack.empty()) {
+		auto operatorNodeValue = topPopNotEmpty(mOperatorStack);
+		auto operandNode2 = topPopNotEmpty(mResultStack);
+		auto operandNode1 = topPopNotEmpty(mResultStack);
 
 		EXCEPT_RETURN(operandNode1);
 		EXCEPT_RETURN(operandNode2);
 		EXCEPT_RETURN(operatorNodeValue);
 
-		auto operatorNode = NodeFactory::create(operatorNodeValue.getValue());
+		auto operatorNode = NodeFactory::create(operatorNodeValue.getValue().Text);
 		NodeFactory::node(operatorNode).nodestate = NodeFactory::Node::NodeState::Operator;
 
 		processNode(operatorNode, operandNode1.getValue(), operandNode2.getValue());
-		resultStack.push(operatorNode);
+		mResultStack.push(operatorNode);
 	}
 
-	if (resultStack.empty())
+	if (mResultStack.empty())
 		return std::vector<NodeFactory::NodePos>{}; // return null
 
-	std::vector<NodeFactory::NodePos> tmp(resultStack.size(), NodeFactory::NodePosNull);
-	for (size_t i{ resultStack.size() }; i > 0; i--) {
-		tmp[i - 1] = resultStack.top();
-		resultStack.pop();
+	std::vector<NodeFactory::NodePos> tmp(mResultStack.size(), NodeFactory::NodePosNull);
+	for (size_t i{ mResultStack.size() }; i > 0; i--) {
+		tmp[i - 1] = mResultStack.top();
+		mResultStack.pop();
 	}
 
 	return tmp;
 }
 
+// what a lexeme is to the PrecedenceClimber, told apart in the order the OperatorTreeBuilder's branches take.
+enum class ClimbRole : int8_t {
+	Operand,
+	Postfix, // written before its operand
+	Prefix, // written after its operand
+	OpenBracket,
+	RawExpressionBracket,
+	CloseBracket,
+	Infix,
+	Unsupported,
+};
+
+static ClimbRole climbRole(const Parser::LexemeClass& lexemeClass) {
+	// a bracket that is an operator or a constant too is stacked as both by the shunting-yard.
+	if ((lexemeClass.IsOpenBracket || lexemeClass.IsCloseBracket) &&
+		(lexemeClass.HasEvalType || lexemeClass.HasLevel || lexemeClass.IsOperand || (lexemeClass.IsOpenBracket && lexemeClass.IsCloseBracket)))
+		return ClimbRole::Unsupported;
+
+	if (lexemeClass.IsOperand)
+		return ClimbRole::Operand;
+	if (lexemeClass.is(Parser::OperatorEvalType::Postfix))
+		return ClimbRole::Postfix;
+	if (lexemeClass.is(Parser::OperatorEvalType::Prefix))
+		return ClimbRole::Prefix;
+	if (lexemeClass.IsCloseBracket)
+		return ClimbRole::CloseBracket;
+	if (lexemeClass.IsOpenBracket)
+		return lexemeClass.IsRawExpressionBracket ? ClimbRole::RawExpressionBracket : ClimbRole::OpenBracket;
+	if (lexemeClass.is(Parser::OperatorEvalType::Infix) && lexemeClass.HasLevel)
+		return ClimbRole::Infix;
+	return ClimbRole::Unsupported;
+}
+
+Parser::PrecedenceClimber::PrecedenceClimber(const Parser& parser, const ParsedLexemes& parsedLexemes, const std::unordered_map<Parser::Lexeme, Lambda>& EvaluatorLambdaFunction, const KeywordOverlay* parameters) :
+	mParser{ &parser }, mParsedLexemes{ &parsedLexemes }, mParameters{ parameters }, mEvaluatorLambdaFunction{ &EvaluatorLambdaFunction }, mEnd{ parsedLexemes.Lexemes.size() } {}
+
+void Parser::PrecedenceClimber::setRange(size_t first, size_t last) {
+	mPosition = first;
+	mEnd = std::min(last, mParsedLexemes->Lexemes.size());
+	mFollowsValue = first > 0;
+}
+
+std::optional<Result<std::vector<NodeFactory::NodePos>>> Parser::PrecedenceClimber::build() {
+	if (!mParser->mIsParserReady)
+		return Result<std::vector<NodeFactory::NodePos>>(RuntimeError<ParserNotReadyError>("Please run parserReady() first!, To make sure that parser is ready."));
+
+	// every lexeme becomes one node at most (the nodes of raw expressions aside), the arena grows once for all of them.
+	if (const size_t nodeCount{ NodeFactory::size() + (mEnd - mPosition) }; nodeCount > NodeFactory::capacity())
+		NodeFactory::reserve(std::max(nodeCount, 2 * NodeFactory::capacity()));
+
+	// expressions written next to each other are trees of their own.
+	std::vector<NodeFactory::NodePos> trees;
+	while (mPosition < mEnd || mCarried != NodeFactory::NodePosNull) {
+		const std::optional<NodeFactory::NodePos> tree{ iExpression(0) };
+		if (!tree) {
+			if (mError)
+				return Result<std::vector<NodeFactory::NodePos>>(*mError);
+			return std::nullopt;
+		}
+		trees.push_back(*tree);
+	}
+	return Result<std::vector<NodeFactory::NodePos>>(std::move(trees));
+}
+
+bool Parser::PrecedenceClimber::iStartsNextExpression() const {
+	switch (climbRole(mParsedLexemes->Classes[mPosition])) {
+	case ClimbRole::Operand:
+	case ClimbRole::Postfix:
+	case ClimbRole::OpenBracket:
+	case ClimbRole::RawExpressionBracket:
+		break;
+	default:
+		return false;
+	}
+
+	// the shunting-yard reduces every waiting operator only for a number right after an operand.
+	if (mOpenBrackets)
+		return false;
+	return !mPendingOperators || (mParsedLexemes->Classes[mPosition].IsNumber && mParsedLexemes->Classes[mPosition - 1].IsOperand);
+}
+
+bool Parser::PrecedenceClimber::iClosesBracket(size_t position, uint32_t bracketId) const {
+	return position < mEnd &&
+		climbRole(mParsedLexemes->Classes[position]) == ClimbRole::CloseBracket &&
+		mParsedLexemes->Classes[position].BracketId == bracketId;
+}
+
+std::optional<NodeFactory::NodePos> Parser::PrecedenceClimber::iExpression(OperatorLevel minLevel) {
+	std::optional<NodeFactory::NodePos> left{ iUnary() };
+
+	while (left && mCarried == NodeFactory::NodePosNull && mPosition < mEnd) {
+		const LexemeClass& lexemeClass{ mParsedLexemes->Classes[mPosition] };
+		const ClimbRole role{ climbRole(lexemeClass) };
+
+		if (role == ClimbRole::Infix) {
+			if (lexemeClass.Level < minLevel)
+				break;
+
+			const LexemeView operatorLexeme{ mParsedLexemes->Lexemes[mPosition++] };
+			mPendingOperators++;
+			const std::optional<NodeFactory::NodePos> right{ iExpression(lexemeClass.Level + 1) };
+			mPendingOperators--;
+			if (!right)
+				return std::nullopt;
+
+			NodeFactory::NodePos operatorNode{ NodeFactory::create(operatorLexeme) };
+			NodeFactory::node(operatorNode).nodestate = NodeFactory::Node::NodeState::Operator;
+			processNode(operatorNode, *left, *right);
+			mLastValue = operatorNode;
+			left = operatorNode;
+		}
+		else if (role == ClimbRole::CloseBracket || iStartsNextExpression())
+			break;
+		else
+			return std::nullopt;
+	}
+	return left;
+}
+
+std::optional<NodeFactory::NodePos> Parser::PrecedenceClimber::iUnary() {
+	NodeFactory::NodePos value{ mCarried };
+
+	if (value != NodeFactory::NodePosNull)
+		mCarried = NodeFactory::NodePosNull;
+	else {
+		// postfix operators apply to what follows them, the innermost first.
+		const size_t firstOperator{ mPosition };
+		while (mPosition < mEnd && climbRole(mParsedLexemes->Classes[mPosition]) == ClimbRole::Postfix)
+			mPosition++;
+		const size_t lastOperator{ mPosition };
+
+		const std::optional<NodeFactory::NodePos> operand{ iPrimary() };
+		if (!operand)
+			return std::nullopt;
+		value = *operand;
+
+		for (size_t ind{ lastOperator }; ind > firstOperator; ind--) {
+			NodeFactory::NodePos operatorNode{ NodeFactory::create(mParsedLexemes->Lexemes[ind - 1]) };
+			NodeFactory::node(operatorNode).nodestate = NodeFactory::Node::NodeState::Operator;
+			NodeFactory::node(operatorNode).rightPos = value;
+			value = operatorNode;
+			mLastValue = operatorNode;
+		}
+	}
+
+	while (mPosition < mEnd) {
+		const ClimbRole role{ climbRole(mParsedLexemes->Classes[mPosition]) };
+
+		if (role == ClimbRole::Prefix) {
+			NodeFactory::NodePos operatorNode{ NodeFactory::create(mParsedLexemes->Lexemes[mPosition++]) };
+			NodeFactory::node(operatorNode).nodestate = NodeFactory::Node::NodeState::Operator;
+			NodeFactory::node(operatorNode).leftPos = value;
+			value = operatorNode;
+			mLastValue = operatorNode;
+		}
+
+		else if (role == ClimbRole::RawExpressionBracket && mSpecialTypes.contains(value)) {
+			std::optional<RawExpression> argument{ iRawExpression() };
+			if (!argument)
+				return std::nullopt;
+
+			if (isLambdaApplication(mSpecialTypes, value, argument->Type)) {
+				Result<NodeFactory::NodePos, std::runtime_error> evaluateNodePos{ iApplyLambda(mSpecialTypes, value, argument->Node, *mEvaluatorLambdaFunction) };
+				if (evaluateNodePos.isError()) {
+					mError = evaluateNodePos.getException();
+					return std::nullopt;
+				}
+				value = evaluateNodePos.getValue();
+				mLastValue = value;
+				continue;
+			}
+
+			// the raw expression starts the next expression, the shunting-yard stacks it for the operators around.
+			if (mPendingOperators || mOpenBrackets)
+				return std::nullopt;
+			mSpecialTypes[argument->Node] = std::move(argument->Type);
+			mCarried = argument->Node;
+			mLastValue = argument->Node;
+			break;
+		}
+
+		else
+			break;
+	}
+	return value;
+}
+
+std::optional<NodeFactory::NodePos> Parser::PrecedenceClimber::iPrimary() {
+	if (mPosition >= mEnd)
+		return std::nullopt;
+
+	const LexemeClass& lexemeClass{ mParsedLexemes->Classes[mPosition] };
+	switch (climbRole(lexemeClass)) {
+	case ClimbRole::Operand: {
+		NodeFactory::NodePos operandNode{ NodeFactory::create(mParsedLexemes->Lexemes[mPosition++]) };
+		if (lexemeClass.is(OperatorEvalType::Constant))
+			NodeFactory::node(operandNode).nodestate = NodeFactory::Node::NodeState::Operator;
+		mLastValue = operandNode;
+		return operandNode;
+	}
+
+	case ClimbRole::OpenBracket: {
+		if (mOpenBrackets >= STACK_CALL_LIMIT)
+			return std::nullopt;
+
+		mPosition++;
+		mOpenBrackets++;
+		const std::optional<NodeFactory::NodePos> expression{ iExpression(0) };
+		mOpenBrackets--;
+		if (!expression || !iClosesBracket(mPosition, lexemeClass.BracketId))
+			return std::nullopt;
+		mPosition++;
+		return expression;
+	}
+
+	case ClimbRole::RawExpressionBracket: {
+		std::optional<RawExpression> rawExpression{ iRawExpression() };
+		if (!rawExpression)
+			return std::nullopt;
+
+		// the shunting-yard applies the last value to it, though an operator or a bracket is written between them.
+		if (mLastValue != NodeFactory::NodePosNull && isLambdaApplication(mSpecialTypes, mLastValue, rawExpression->Type))
+			return std::nullopt;
+
+		mSpecialTypes[rawExpression->Node] = std::move(rawExpression->Type);
+		mLastValue = rawExpression->Node;
+		return rawExpression->Node;
+	}
+
+	default:
+		return std::nullopt;
+	}
+}
+
+std::optional<Parser::PrecedenceClimber::RawExpression> Parser::PrecedenceClimber::iRawExpression() {
+	const LexemeClass& openBracket{ mParsedLexemes->Classes[mPosition++] };
+	LexemeView rawExpression;
+	std::span<const RawStringSpan> nestedRawStrings;
+
+	// the lexer gives the whole raw expression as one lexeme, nothing at all when it is empty.
+	if (!iClosesBracket(mPosition, openBracket.BracketId)) {
+		if (mPosition >= mEnd)
+			return std::nullopt;
+
+		const LexemeClass& lexemeClass{ mParsedLexemes->Classes[mPosition] };
+		if (!lexemeClass.IsOperand && (lexemeClass.IsCloseBracket || (lexemeClass.is(OperatorEvalType::Prefix) && (mLastValue != NodeFactory::NodePosNull || mFollowsValue))))
+			return std::nullopt;
+
+		rawExpression = mParsedLexemes->Lexemes[mPosition];
+		if (!lexemeClass.IsOperand)
+			nestedRawStrings = ::nestedRawStrings(mParsedLexemes->Content, mParsedLexemes->RawStrings, mNextRawString, rawExpression);
+		if (!iClosesBracket(++mPosition, openBracket.BracketId))
+			return std::nullopt;
+	}
+	mPosition++;
+
+	Result<NodeFactory::NodePos> rawExpressionNode{ (openBracket.RawExpressionType == NodeFactory::Node::NodeState::LambdaFuntion ||
+		openBracket.RawExpressionType == NodeFactory::Node::NodeState::Storage) ?
+		mParser->createRawExpressionOperatorTree(rawExpression, openBracket.RawExpressionType, *mEvaluatorLambdaFunction, nestedRawStrings, mParameters) :
+		NodeFactory::create(rawExpression) };
+	if (rawExpressionNode.isError()) {
+		mError = rawExpressionNode.getException();
+		return std::nullopt;
+	}
+
+	Result<RuntimeType, std::runtime_error> returnType{ getReturnType(rawExpressionNode.getValue(), *mEvaluatorLambdaFunction) };
+	if (returnType.isError()) {
+		mError = returnType.getException();
+		return std::nullopt;
+	}
+	return RawExpression{ rawExpressionNode.getValue(), returnType.moveValue() };
+}
+
+Result<std::vector<NodeFactory::NodePos>> Parser::createOperatorTree(const std::vector<LexemeView>& parsedLexemes, const std::unordered_map<Parser::Lexeme, Lambda>& EvaluatorLambdaFunction) const {
+	ParsedLexemes classifiedLexemes;
+	classifiedLexemes.Lexemes = parsedLexemes;
+	classifiedLexemes.Classes.reserve(parsedLexemes.size());
+	for (const LexemeView parsedLexeme : parsedLexemes)
+		classifiedLexemes.Classes.push_back(iLexemeClass(parsedLexeme));
+	return createOperatorTree(classifiedLexemes, EvaluatorLambdaFunction);
+}
+
+Result<std::vector<NodeFactory::NodePos>> Parser::createOperatorTree(const ParsedLexemes& parsedLexemes, const std::unordered_map<Parser::Lexeme, Lambda>& EvaluatorLambdaFunction) const {
+	if (std::optional<std::vector<NodeFactory::NodePos>> operatorTree{ iCreateOperatorTreeParallel(parsedLexemes, EvaluatorLambdaFunction) })
+		return std::move(*operatorTree);
+	return iCreateOperatorTree(parsedLexemes, EvaluatorLambdaFunction, nullptr);
+}
+
+// the infix operators of the lowest level written outside brackets, where a parallel parse splits the lexemes.
+// empty when a lexeme the climber doesn't read is written, the lexemes are never split then.
+static std::vector<size_t> lowestOperators(const ParsedLexemes& parsedLexemes) {
+	std::vector<size_t> operators;
+	std::optional<Parser::OperatorLevel> lowestLevel;
+	size_t openBrackets{ 0 };
+
+	for (size_t ind{ 0 }; ind < parsedLexemes.Lexemes.size(); ind++) {
+		const Parser::LexemeClass& lexemeClass{ parsedLexemes.Classes[ind] };
+		switch (climbRole(lexemeClass)) {
+		case ClimbRole::RawExpressionBracket:
+			// the raw expression is one lexeme, whatever it holds.
+			if (ind + 1 < parsedLexemes.Lexemes.size() &&
+				!(climbRole(parsedLexemes.Classes[ind + 1]) == ClimbRole::CloseBracket && parsedLexemes.Classes[ind + 1].BracketId == lexemeClass.BracketId))
+				ind++;
+			openBrackets++;
+			break;
+		case ClimbRole::OpenBracket:
+			openBrackets++;
+			break;
+		case ClimbRole::CloseBracket:
+			if (!openBrackets)
+				return {};
+			openBrackets--;
+			break;
+		case ClimbRole::Infix:
+			if (openBrackets)
+				break;
+			if (!lowestLevel || lexemeClass.Level < *lowestLevel) {
+				lowestLevel = lexemeClass.Level;
+				operators.clear();
+			}
+			if (lexemeClass.Level == *lowestLevel)
+				operators.push_back(ind);
+			break;
+		case ClimbRole::Unsupported:
+			return {};
+		default:
+			break;
+		}
+	}
+	return operators;
+}
+
+std::optional<std::vector<NodeFactory::NodePos>> Parser::iCreateOperatorTreeParallel(const ParsedLexemes& parsedLexemes, const std::unordered_map<Parser::Lexeme, Lambda>& EvaluatorLambdaFunction) const {
+	const size_t lexemeAmount{ parsedLexemes.Lexemes.size() };
+	const size_t pieceAmount{ std::min(mParseThreads, lexemeAmount / ParallelParseMinLexemes) };
+	if (mOperatorTreeEngine != OperatorTreeEngine::PrecedenceClimbing || !mIsParserReady || pieceAmount < 2)
+		return std::nullopt;
+
+	// the operators joining the pieces, about the same amount of lexemes apart. The first lowest operator joins none,
+	// the value before it is the one a raw expression after it would be applied to.
+	const std::vector<size_t> operators{ lowestOperators(parsedLexemes) };
+	std::vector<size_t> joints{ 0 }; // indexes operators, the piece ind starts after operators[joints[ind]]
+	for (size_t piece{ 1 }; piece < pieceAmount; piece++) {
+		const size_t joint{ static_cast<size_t>(std::lower_bound(operators.begin(), operators.end(), piece * lexemeAmount / pieceAmount) - operators.begin()) };
+		if (joint >= operators.size())
+			break;
+		if (joint > joints.back())
+			joints.push_back(joint);
+	}
+	if (joints.size() < 2)
+		return std::nullopt;
+
+	// every piece is climbed into a factory of its own, the first one into the calling thread's.
+	std::vector<NodeFactory> factories(joints.size() - 1);
+	std::vector<std::vector<NodeFactory::NodePos>> pieceTrees(joints.size()); // the root and the first lowest operator of every piece
+	const auto buildPiece{ [&](size_t piece) {
+		const size_t first{ piece ? operators[joints[piece]] + 1 : 0 };
+		const size_t last{ piece + 1 < joints.size() ? operators[joints[piece + 1]] : lexemeAmount };
+
+		try {
+			PrecedenceClimber climber{ *this, parsedLexemes, EvaluatorLambdaFunction };
+			climber.setRange(first, last);
+			std::optional<Result<std::vector<NodeFactory::NodePos>>> trees{ climber.build() };
+			if (!trees || trees->isError() || trees->getValue().size() != 1)
+				return;
+
+			// the lowest operators of a piece are the left spine of its tree, the first one holds the first operand.
+			const NodeFactory::NodePos root{ trees->getValue().front() };
+			NodeFactory::NodePos firstOperator{ NodeFactory::NodePosNull };
+			const size_t lowestAmount{ piece ? (piece + 1 < joints.size() ? joints[piece + 1] : operators.size()) - joints[piece] - 1 : 0 };
+			for (size_t ind{ 0 }; ind < lowestAmount; ind++)
+				firstOperator = ind ? NodeFactory::node(firstOperator).leftPos : root;
+			pieceTrees[piece] = { root, firstOperator };
+		}
+		catch (const std::exception&) {
+			// a piece left without trees sends the lexemes to the serial parse, which throws it again.
+		}
+	} };
+
+	const NodeFactory::Region pieceRegion{ NodeFactory::mark() };
+	{
+		std::vector<std::jthread> workers;
+		for (size_t piece{ 1 }; piece < joints.size(); piece++)
+			workers.emplace_back([&, piece]() {
+				NodeFactory::Scope pieceScope{ factories[piece - 1] };
+				buildPiece(piece);
+			});
+		buildPiece(0);
+	}
+
+	if (std::ranges::any_of(pieceTrees, [](const std::vector<NodeFactory::NodePos>& trees) { return trees.empty(); })) {
+		NodeFactory::rewind(pieceRegion);
+		return std::nullopt;
+	}
+
+	std::vector<NodeFactory*> sources;
+	for (NodeFactory& factory : factories)
+		sources.push_back(&factory);
+	NodeFactory::adopt(sources, std::span(pieceTrees).subspan(1));
+	NodeFactory::keep(pieceRegion);
+
+	// the tree of the pieces before becomes the left operand of a piece's first lowest operator, through the joining one.
+	NodeFactory::NodePos tree{ pieceTrees.front().front() };
+	for (size_t piece{ 1 }; piece < joints.size(); piece++) {
+		const NodeFactory::NodePos root{ pieceTrees[piece][0] };
+		const NodeFactory::NodePos firstOperator{ pieceTrees[piece][1] };
+		NodeFactory::NodePos jointNode{ NodeFactory::create(parsedLexemes.Lexemes[operators[joints[piece]]]) };
+		NodeFactory::node(jointNode).nodestate = NodeFactory::Node::NodeState::Operator;
+
+		if (firstOperator == NodeFactory::NodePosNull) {
+			processNode(jointNode, tree, root);
+			tree = jointNode;
+		}
+		else {
+			processNode(jointNode, tree, NodeFactory::node(firstOperator).leftPos);
+			NodeFactory::node(firstOperator).leftPos = jointNode;
+			tree = root;
+		}
+	}
+	return std::vector<NodeFactory::NodePos>{ tree };
+}
+
+Result<std::vector<NodeFactory::NodePos>> Parser::iCreateOperatorTree(const ParsedLexemes& parsedLexemes, const std::unordered_map<Parser::Lexeme, Lambda>& EvaluatorLambdaFunction, const KeywordOverlay* parameters) const {
+	if (mOperatorTreeEngine == OperatorTreeEngine::PrecedenceClimbing) {
+		// what the climber built before giving up is given back, the shunting-yard starts over.
+		const NodeFactory::Region climbRegion{ NodeFactory::mark() };
+		if (std::optional<Result<std::vector<NodeFactory::NodePos>>> operatorTree{ PrecedenceClimber{ *this, parsedLexemes, EvaluatorLambdaFunction, parameters }.build() }) {
+			NodeFactory::keep(climbRegion);
+			return std::move(*operatorTree);
+		}
+		NodeFactory::rewind(climbRegion);
+	}
+
+	OperatorTreeBuilder operatorTreeBuilder{ *this, EvaluatorLambdaFunction, false, parameters };
+	operatorTreeBuilder.setRawStrings(parsedLexemes.Content, parsedLexemes.RawStrings);
+	for (size_t ind{ 0 }; ind < parsedLexemes.Lexemes.size(); ind++)
+		operatorTreeBuilder.push(parsedLexemes.Lexemes[ind], parsedLexemes.Classes[ind]);
+	return operatorTreeBuilder.finish();
+}
+
+Parser::ExpressionStream::ExpressionStream(const Parser& parser, const std::unordered_map<Parser::Lexeme, Lambda>& EvaluatorLambdaFunction) :
+	mNumberMerger{ parser }, mOperatorTreeBuilder{ parser, EvaluatorLambdaFunction, true } {}
+
+void Parser::ExpressionStream::iBuild(bool lastBatch) {
+	mMerged.clear();
+	mNumberMerger.feed(mLexemes, true, lastBatch, mMerged);
+	for (size_t ind{ 0 }; ind < mMerged.Lexemes.size(); ind++)
+		mOperatorTreeBuilder.push(mMerged.Lexemes[ind], mMerged.Classes[ind]);
+}
+
+void Parser::ExpressionStream::feed(const TokenStream& tokenStream, const std::vector<Token>& tokens) {
+	mLexemes.clear();
+	for (const Token& token : tokens)
+		mLexemes.emplace_back(tokenStream.text(token));
+	iBuild(false);
+}
+
+Result<std::vector<NodeFactory::NodePos>> Parser::ExpressionStream::finish() {
+	mLexemes.clear();
+	iBuild(true);
+	return mOperatorTreeBuilder.finish();
+}
+
+Result<std::vector<NodeFactory::NodePos>> Parser::createOperatorTree(const std::vector<Lexeme>& parsedLexemes, const std::unordered_map<Parser::Lexeme, Lambda>& EvaluatorLambdaFunction) const {
+	return createOperatorTree(std::vector<LexemeView>(parsedLexemes.begin(), parsedLexemes.end()), EvaluatorLambdaFunction);
+}
+
 NodeFactory::NodePos Parser::createRawExpressionStorage(const std::vector<NodeFactory::NodePos>& parsedExpressions) const {
 	NodeFactory::NodePos root = NodeFactory::create();
 	NodeFactory::NodePos tail = root;
@@ -468,10 +1154,10 @@ NodeFactory::NodePos Parser::createRawExpressionStorage(const std::vector<NodeFa
 	return root;
 }
 
-bool Parser::checkIfValidParameterName(const std::string& parameter) const {
+bool Parser::checkIfValidParameterName(const std::string& parameter, const KeywordOverlay* enclosingParameters) const {
 	if (strictedIsNumber(parameter, true))
 		return false;
-	if (mOperatorEvalTypes.contains(parameter))
+	if (mOperatorEvalTypes.contains(parameter) || (enclosingParameters && enclosingParameters->contains(parameter)))
 		return false;
 	if (mBracketsOperators.closeBracketsOperators.contains(parameter) ||
 		mBracketsOperators.openBracketsOperators.contains(parameter))
@@ -481,13 +1167,13 @@ bool Parser::checkIfValidParameterName(const std::string& parameter) const {
 	return true;
 }
 
-std::optional<std::runtime_error> Parser::getLambdaType(std::vector<std::pair<std::string, RuntimeType>>& parametersWithTypes, std::string parameterExpression) const {
+std::optional<std::runtime_error> Parser::getLambdaType(std::vector<std::pair<std::string, RuntimeType>>& parametersWithTypes, std::string parameterExpression, const KeywordOverlay* enclosingParameters) const {
 	std::regex pattern("(\\w+)(?::(\\w+(?:\\[\\w+(?:,\\w+)?\\])?))?");
 	std::smatch matches;
 
 	while (std::regex_search(parameterExpression, matches, pattern)) {
 		if (matches[2].str().empty()) {
-			if (!checkIfValidParameterName(matches[1].str()))
+			if (!checkIfValidParameterName(matches[1].str(), enclosingParameters))
 				return RuntimeError<ParserSyntaxError>(
 					std::format(
 						"The parameter name \"{}\" is not valid. Parameter names cannot be operators, numbers, or brackets.",
@@ -518,47 +1204,85 @@ std::optional<std::runtime_error> Parser::getLambdaType(std::vector<std::pair<st
 	return std::nullopt;
 }
 
-Result<NodeFactory::NodePos> Parser::createRawExpressionOperatorTree(const std::string& RawExpression, NodeFactory::Node::NodeState RawExpressionType, const std::unordered_map<Parser::Lexeme, Lambda>& EvaluatorLambdaFunction) const
+// resolves every reference to one of the lambda's own parameters to its slot, nested lambdas bind their own.
+static void bindParameterSlots(NodeFactory::NodePos lambdaNode, const NodeFactory::ParameterList& parameters) {
+	std::stack<NodeFactory::NodePos> nodes;
+	nodes.push(lambdaNode);
+
+	while (!nodes.empty()) {
+		const NodeFactory::NodePos currNodePos{ nodes.top() }; nodes.pop();
+		NodeFactory::Node currNode{ NodeFactory::node(currNodePos) };
+
+		if (currNode.nodestate == NodeFactory::Node::NodeState::LambdaFuntion && currNodePos != lambdaNode)
+			continue;
+
+		currNode.clearType(); // typed while parsing the body, before the parameters were known.
+
+		if (!NodeFactory::validNode(currNode.leftPos) && !NodeFactory::validNode(currNode.rightPos)) {
+			if (currNode.isNumber())
+				continue;
+
+			const auto parameterIt{ std::ranges::find(parameters, currNode.value(), &NodeFactory::ParameterList::value_type::first) };
+			if (parameterIt != parameters.end())
+				currNode.setParameterSlot(static_cast<uint32_t>(parameterIt - parameters.begin()));
+			continue;
+		}
+
+		if (NodeFactory::validNode(currNode.leftPos))
+			nodes.push(currNode.leftPos);
+		if (NodeFactory::validNode(currNode.rightPos))
+			nodes.push(currNode.rightPos);
+	}
+}
+
+Result<NodeFactory::NodePos> Parser::createRawExpressionOperatorTree(std::string_view RawExpression, NodeFactory::Node::NodeState RawExpressionType, const std::unordered_map<Parser::Lexeme, Lambda>& EvaluatorLambdaFunction, std::span<const RawStringSpan> nestedRawStrings, const KeywordOverlay* enclosingParameters) const
 {
-	std::string_view rawVariablesExpression;
-	std::string_view rawOperationTree(RawExpression);
+	size_t operationTreeBegin{ 0 };
 
 	bool foundParameterSlot{ false };
-	Parser pas(*this); // very expensive
 
-	std::vector<std::string> rawExpressionLexemes = initializeStaticLexer(std::vector<std::string>{ ",", ";", "Number", "Storage", "Lambda" })(RawExpression);
+	// the raw strings nested in RawExpression are listed by the first lex that passes over them, the lexes after it
+	// (the one of the operation tree here and those of the nested lambdas) skip them in one step.
+	static constexpr std::array<std::string_view, 5> parameterSplitKeywords{ ",", ";", "Lambda", "Number", "Storage" }; // sorted
+	static const KeywordOverlay parameterSplitOverlay{ parameterSplitKeywords };
+	std::vector<RawStringSpan> foundRawStrings;
+	const std::vector<Token> rawExpressionTokens{ initializeStaticLexer(&parameterSplitOverlay)(RawExpression, 0, nestedRawStrings, &foundRawStrings) };
+	const std::span<const RawStringSpan> rawStrings{ nestedRawStrings.empty() ? std::span<const RawStringSpan>(foundRawStrings) : nestedRawStrings };
 	std::vector<std::pair<std::string, RuntimeType>> variableLexemesWithTypes;
-
-	auto variableSpilterIndexExist{ std::ranges::find(rawExpressionLexemes, ";") };
-
-	if (auto variableSpilterIndex{ std::ranges::find(RawExpression, ';') };
-		variableSpilterIndexExist != rawExpressionLexemes.end() && variableSpilterIndex != RawExpression.end()) {
-		rawVariablesExpression = std::string_view(RawExpression.begin(), variableSpilterIndex);
-		rawOperationTree = std::string_view(++variableSpilterIndex, RawExpression.end());
+	// the parameters are keywords and constants of the operation tree, next to those of the enclosing lambdas.
+	std::vector<std::string_view> parameterKeywords;
+	KeywordOverlay parameterKeywordOverlay{ {}, enclosingParameters };
+	const KeywordOverlay* parameters{ enclosingParameters };
+
+	if (auto variableSpilter{ std::ranges::find(rawExpressionTokens, ";", [RawExpression](const Token& token) { return token.text(RawExpression); }) };
+		variableSpilter != rawExpressionTokens.end()) {
+		// the first ";" of the text, which is the token's unless a raw string before it holds one.
+		const size_t variableSpilterIndex{ RawExpression.substr(0, variableSpilter->Offset).find(';') };
+		const std::string_view rawVariablesExpression{ RawExpression.substr(0, std::min(variableSpilterIndex, variableSpilter->Offset)) };
+		operationTreeBegin = rawVariablesExpression.size() + 1;
 
 		foundParameterSlot = true;
-		if (std::optional<std::runtime_error> parameterParsingError{ getLambdaType(variableLexemesWithTypes, std::string(rawVariablesExpression)) }; parameterParsingError.has_value())
+		if (std::optional<std::runtime_error> parameterParsingError{ getLambdaType(variableLexemesWithTypes, std::string(rawVariablesExpression), enclosingParameters) }; parameterParsingError.has_value())
 			return parameterParsingError.value();
 
-		for (const auto& [variableLexeme, _] : variableLexemesWithTypes) {
-			pas.addOperatorEvalType(variableLexeme, Parser::OperatorEvalType::Constant);
-			pas.addOperatorLevel(variableLexeme, 9);
-			pas.mTempConstant.emplace(variableLexeme);
-		}
+		for (const auto& [variableLexeme, _] : variableLexemesWithTypes)
+			parameterKeywords.emplace_back(variableLexeme);
+		std::ranges::sort(parameterKeywords);
+		parameterKeywordOverlay.Words = parameterKeywords;
+		parameters = &parameterKeywordOverlay;
 	}
 
-	auto operationTree = initializeStaticLexer(pas.mTempConstant)(std::string(rawOperationTree));
-	auto parsedNumberOperationTree = parseNumbers(operationTree);
-
-	pas._ignore_parserReady();
-	auto fullyParsedOperationTree = pas.createOperatorTree(parsedNumberOperationTree, EvaluatorLambdaFunction);
+	const std::vector<Token> operationTree{ initializeStaticLexer(parameters)(RawExpression, operationTreeBegin, rawStrings, nullptr) };
+	const ParsedLexemes parsedNumberOperationTree{ iParseNumbers(RawExpression, operationTree, rawStrings, parameters) };
+	auto fullyParsedOperationTree = iCreateOperatorTree(parsedNumberOperationTree, EvaluatorLambdaFunction, parameters);
 	EXCEPT_RETURN(fullyParsedOperationTree);
 
 	if (RawExpressionType == NodeFactory::Node::NodeState::LambdaFuntion) {
 		NodeFactory::NodePos operatorNode = createRawExpressionStorage(fullyParsedOperationTree.getValue());
 		NodeFactory::node(operatorNode).nodestate = NodeFactory::Node::NodeState::LambdaFuntion;
-		NodeFactory::node(operatorNode).utilityStorage = variableLexemesWithTypes;
-		NodeFactory::node(operatorNode).value = std::format("lambda");
+		NodeFactory::node(operatorNode).setUtilityStorage(variableLexemesWithTypes);
+		NodeFactory::node(operatorNode).setValue("lambda");
+		bindParameterSlots(operatorNode, variableLexemesWithTypes);
 
 		return operatorNode;
 	}
@@ -571,7 +1295,7 @@ Result<NodeFactory::NodePos> Parser::createRawExpressionOperatorTree(const std::
 		else
 			operatorNode = createRawExpressionStorage(fullyParsedOperationTree.getValue());
 
-		NodeFactory::node(operatorNode).value = std::format("storage");
+		NodeFactory::node(operatorNode).setValue("storage");
 		NodeFactory::node(operatorNode).nodestate = NodeFactory::Node::NodeState::Storage;
 
 		return operatorNode;
@@ -586,7 +1310,7 @@ Result<NodeFactory::NodePos> Parser::createRawExpressionOperatorTree(const std::
 	);
 }
 
-static std::string _printOpertatorTree(NodeFactory::NodePos tree, const std::unordered_map<Parser::Lexeme, Parser::OperatorEvalType>& mOperatorEvalTypes, size_t _level) {
+static std::string _printOpertatorTree(NodeFactory::NodePos tree, const StringMap<Parser::OperatorEvalType>& mOperatorEvalTypes, size_t _level) {
 	const auto& treeNode = NodeFactory::node(tree); // guarantee no modification, if isn't treeNode can be dangling reference.
 
 	// if tree is null
@@ -599,15 +1323,15 @@ static std::string _printOpertatorTree(NodeFactory::NodePos tree, const std::uno
 	// if a number
 	if (!NodeFactory::validNode(treeNode.leftPos) && !NodeFactory::validNode(treeNode.rightPos)) {
 		if (treeNode.nodestate == NodeFactory::Node::NodeState::Operator)
-			return ColorText<Color::Bright_Magenta>(treeNode.value);
-		return ColorText<Color::Bright_Blue>(treeNode.value);
+			return ColorText<Color::Bright_Magenta>(treeNode.value());
+		return ColorText<Color::Bright_Blue>(treeNode.value());
 	}
 
 	std::stringstream result{};
 
 	// if a lambda function
 	if (treeNode.nodestate == NodeFactory::Node::NodeState::LambdaFuntion) {
-		const std::vector <std::pair<std::string, RuntimeType>>& parameters = treeNode.utilityStorage;
+		const std::vector <std::pair<std::string, RuntimeType>>& parameters = treeNode.utilityStorage();
 		std::vector<std::string> arguments;
 		std::vector<std::string> expressions;
 
@@ -646,20 +1370,20 @@ static std::string _printOpertatorTree(NodeFactory::NodePos tree, const std::uno
 	}
 
 	// if a operator
-	switch (mOperatorEvalTypes.at(treeNode.value))
+	switch (mOperatorEvalTypes.at(treeNode.value()))
 	{
 		using enum Parser::OperatorEvalType;
 	case Prefix:
 		result << (NodeFactory::validNode(treeNode.leftPos) ? _printOpertatorTree(treeNode.leftPos, mOperatorEvalTypes, _level + 1) : "null")
-			<< " " << ColorText<Color::Cyan>(treeNode.value);
+			<< " " << ColorText<Color::Cyan>(treeNode.value());
 		break;
 	case Infix:
 		result << (NodeFactory::validNode(treeNode.leftPos) ? _printOpertatorTree(treeNode.leftPos, mOperatorEvalTypes, _level + 1) : "null")
-			<< " " << ColorText<Color::Cyan>(treeNode.value) << " "
+			<< " " << ColorText<Color::Cyan>(treeNode.value()) << " "
 			<< (NodeFactory::validNode(treeNode.rightPos) ? _printOpertatorTree(treeNode.rightPos, mOperatorEvalTypes, _level + 1) : "null");
 		break;
 	case Postfix:
-		result << ColorText<Color::Cyan>(treeNode.value) << " "
+		result << ColorText<Color::Cyan>(treeNode.value()) << " "
 			<< (NodeFactory::validNode(treeNode.rightPos) ? _printOpertatorTree(treeNode.rightPos, mOperatorEvalTypes, _level + 1) : "null");
 		break;
 	default:
@@ -695,7 +1419,7 @@ std::string Parser::printOpertatorTree(std::vector<NodeFactory::NodePos> trees,
 					storageResult.getException(),
 					std::format(
 						"When attempting to convert a NodeExpression into a storage for evaluation. (nodeExpression value = {})",
-						NodeFactory::validNode(currNode) ? NodeFactory::node(currNode).value : "Null"
+						NodeFactory::validNode(currNode) ? NodeFactory::node(currNode).value() : "Null"
 					),
 					"Lambda::_NodeExpressionsEvaluator"
 				).what();
@@ -726,7 +1450,7 @@ std::string Parser::printOpertatorTree(std::vector<NodeFactory::NodePos> trees,
 		NodeFactory::NodePos root{ evalutationResults[ind] };
 
 		if (NodeFactory::node(root).nodestate == NodeFactory::Node::NodeState::LambdaFuntion) {
-			const std::vector<std::pair<std::string, RuntimeType>>& parameters{ NodeFactory::node(root).leftNode().utilityStorage };
+			const std::vector<std::pair<std::string, RuntimeType>>& parameters{ NodeFactory::node(root).leftNode().utilityStorage() };
 			std::vector<NodeFactory::NodePos> arguments;
 
 			NodeFactory::NodePos currNodePos = NodeFactory::node(root).rightPos;
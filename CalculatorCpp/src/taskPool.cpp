@@ -0,0 +1,179 @@
+#include "taskPool.h"
+
+#include <algorithm>
+
+TaskPool::Task::Task(std::function<void()> work) :
+	mWork{ std::move(work) } {}
+
+bool TaskPool::Task::iClaim() {
+	uint8_t expected{ Pending };
+	return mState.compare_exchange_strong(expected, Running);
+}
+
+void TaskPool::Task::iRun() {
+	try {
+		mWork();
+	}
+	catch (...) {
+		mException = std::current_exception();
+	}
+
+	mState.store(Done);
+	mState.notify_all();
+}
+
+TaskPool::Group::Group(TaskPool& pool) :
+	mPool{ pool } {}
+
+// discarding a task that is done returns right away.
+TaskPool::Group::~Group() {
+	for (const std::shared_ptr<Task>& task : mTasks)
+		mPool.discard(*task);
+}
+
+TaskPool::Task& TaskPool::Group::spawn(std::function<void()> work) {
+	const std::shared_ptr<Task>& task{ mTasks.emplace_back(std::make_shared<Task>(std::move(work))) };
+	mPool.spawn(task);
+	return *task;
+}
+
+void TaskPool::Group::join(Task& task) {
+	mPool.join(task);
+}
+
+TaskPool& TaskPool::instance() {
+	static TaskPool pool;
+	return pool;
+}
+
+TaskPool::TaskPool() {
+	iStartWorkers(std::max(std::thread::hardware_concurrency(), 1u) - 1);
+}
+
+TaskPool::~TaskPool() {
+	iStopWorkers();
+}
+
+size_t TaskPool::workerAmount() const {
+	return mWorkers.size();
+}
+
+void TaskPool::setWorkerAmount(size_t workerAmount) {
+	if (workerAmount == mWorkers.size())
+		return;
+
+	iStopWorkers();
+	iStartWorkers(workerAmount);
+}
+
+void TaskPool::iStartWorkers(size_t workerAmount) {
+	mStop = false;
+	mQueues.clear();
+	for (size_t ind{ 0 }; ind <= workerAmount; ind++)
+		mQueues.emplace_back(std::make_unique<Queue>());
+
+	for (size_t ind{ 1 }; ind <= workerAmount; ind++)
+		mWorkers.emplace_back([this, ind] { iWorkerLoop(ind); });
+}
+
+void TaskPool::iStopWorkers() {
+	{
+		std::lock_guard lock{ mSleepMutex };
+		mStop = true;
+	}
+	mWakeUp.notify_all();
+	mWorkers.clear(); // joins them.
+}
+
+void TaskPool::iWorkerLoop(size_t queueIndex) {
+	mLocalQueue = queueIndex;
+
+	while (true) {
+		if (const std::shared_ptr<Task> task{ iFindTask() }) {
+			task->iRun();
+			continue;
+		}
+
+		std::unique_lock lock{ mSleepMutex };
+		mWakeUp.wait(lock, [this] { return mStop || mPendingTasks.load() > 0; });
+		if (mStop)
+			return;
+	}
+}
+
+void TaskPool::spawn(std::shared_ptr<Task> task) {
+	// counted before it is queued, a thread that sees the count finds the task once the push is done.
+	mPendingTasks++;
+	{
+		Queue& queue{ *mQueues[mLocalQueue] };
+		std::lock_guard lock{ queue.mutex };
+		queue.tasks.emplace_back(std::move(task));
+	}
+
+	if (!mWorkers.empty()) {
+		{ std::lock_guard lock{ mSleepMutex }; }
+		mWakeUp.notify_one();
+	}
+}
+
+// the own queue from the back (the latest spawn, likely still in cache), then every queue from the front.
+// Entries another thread claimed in the meantime are dropped on the way.
+std::shared_ptr<TaskPool::Task> TaskPool::iFindTask() {
+	auto claim = [this](std::shared_ptr<Task>& task) {
+		if (!task->iClaim())
+			return false;
+		mPendingTasks--;
+		return true;
+	};
+
+	if (mLocalQueue) {
+		Queue& queue{ *mQueues[mLocalQueue] };
+		std::lock_guard lock{ queue.mutex };
+		while (!queue.tasks.empty()) {
+			std::shared_ptr<Task> task{ std::move(queue.tasks.back()) };
+			queue.tasks.pop_back();
+			if (claim(task))
+				return task;
+		}
+	}
+
+	for (size_t offset{ 1 }; offset <= mQueues.size(); offset++) {
+		Queue& queue{ *mQueues[(mLocalQueue + offset) % mQueues.size()] };
+		std::lock_guard lock{ queue.mutex };
+		while (!queue.tasks.empty()) {
+			std::shared_ptr<Task> task{ std::move(queue.tasks.front()) };
+			queue.tasks.pop_front();
+			if (claim(task))
+				return task;
+		}
+	}
+	return nullptr;
+}
+
+void TaskPool::join(Task& task) {
+	if (task.iClaim()) {
+		mPendingTasks--;
+		task.iRun();
+	}
+
+	while (task.mState.load() != Task::Done) {
+		if (const std::shared_ptr<Task> other{ iFindTask() }) {
+			other->iRun();
+			continue;
+		}
+		task.mState.wait(Task::Running);
+	}
+
+	if (task.mException)
+		std::rethrow_exception(task.mException);
+}
+
+void TaskPool::discard(Task& task) {
+	uint8_t expected{ Task::Pending };
+	if (task.mState.compare_exchange_strong(expected, Task::Done)) {
+		mPendingTasks--;
+		return;
+	}
+
+	task.mState.wait(Task::Running);
+}
@@ -1,76 +1,181 @@
 #include "trieTree.h"
+#include <algorithm>
+#include <functional>
+#include <ranges>
 
-void TrieTree::insert(const std::string& word) {
-	TrieNode* currNode = root.get();
+TrieTree::TrieTree() {
+	iRebuild();
+}
+
+TrieTree::TrieTree(const std::vector<std::string>& mainKeywords) : validWords(mainKeywords.begin(), mainKeywords.end()) {
+	iRebuild();
+}
+
+TrieTree::State TrieTree::iAddState() {
+	const State state{ static_cast<State>(mEndOfWord.size()) };
+	mTransitions.resize(mTransitions.size() + mClassCount, DeadState);
+	mEndOfWord.emplace_back(false);
+	return state;
+}
+
+void TrieTree::iAddClass(unsigned char chr) {
+	const size_t classCount{ mClassCount + 1 };
+	std::vector<State> transitions(mEndOfWord.size() * classCount, DeadState);
+
+	for (size_t state{ 0 }; state < mEndOfWord.size(); state++)
+		std::copy_n(mTransitions.begin() + state * mClassCount, mClassCount, transitions.begin() + state * classCount);
+
+	mByteClass[chr] = static_cast<uint16_t>(mClassCount);
+	mClassCount = classCount;
+	mTransitions = std::move(transitions);
+}
+
+void TrieTree::iInsertPath(const std::string& word) {
+	State currState{ RootState };
 	for (char chr : word) {
-		if (!currNode->children.contains(chr)) {
-			currNode->children[chr] = std::make_unique<TrieNode>();
+		if (!mByteClass[static_cast<unsigned char>(chr)])
+			iAddClass(static_cast<unsigned char>(chr));
+
+		State nextState{ iNextState(currState, chr) };
+		if (nextState == DeadState) {
+			nextState = iAddState();
+			mTransitions[currState * mClassCount + mByteClass[static_cast<unsigned char>(chr)]] = nextState;
 		}
-		currNode = currNode->children[chr].get();
+		currState = nextState;
 	}
-	currNode->isEndOfWord = true;
-	validWords.insert(word);
+	mEndOfWord[currState] = true;
 }
 
-bool TrieTree::search(const std::string& word) const {
-	return validWords.contains(word);
+void TrieTree::iRebuild() {
+	mByteClass.fill(0);
+	mClassCount = 1;
+	mTransitions.clear();
+	mEndOfWord.clear();
+	mUnreachableStates = 0;
+
+	iAddState(); // DeadState
+	iAddState(); // RootState
+	for (const std::string& word : validWords)
+		iInsertPath(word);
 }
 
-bool TrieTree::startsWith(const std::string& prefix) const {
-	TrieNode* currNode = root.get();
-	for (char chr : prefix) {
-		if (currNode->children.contains(chr)) {
+void TrieTree::insert(const std::string& word) {
+	if (validWords.insert(word).second)
+		iInsertPath(word);
+}
+
+bool TrieTree::search(std::string_view word) const {
+	State currState{ RootState };
+	for (char chr : word) {
+		currState = iNextState(currState, chr);
+		if (currState == DeadState)
 			return false;
-		}
-		currNode = currNode->children[chr].get();
 	}
-	return true;
+	return mEndOfWord[currState];
 }
 
-bool TrieTree::remove(const std::string& word) {
-	TrieNode* currNode = root.get();
-	std::vector<std::pair<TrieNode*, char>> path;
-
-	for (char chr : word) {
-		if (!currNode->children.contains(chr)) 
+bool TrieTree::startsWith(std::string_view prefix) const {
+	State currState{ RootState };
+	for (char chr : prefix) {
+		currState = iNextState(currState, chr);
+		if (currState == DeadState)
 			return false;
-		path.emplace_back(currNode, chr);
-		currNode = currNode->children[chr].get();
 	}
+	return true;
+}
 
-	if (!currNode->isEndOfWord)
+bool TrieTree::remove(const std::string& word) {
+	if (!validWords.erase(word))
 		return false;
-	
 
-	currNode->isEndOfWord = false;
-	validWords.erase(word);
+	std::vector<State> path{ RootState };
+	for (char chr : word)
+		path.emplace_back(iNextState(path.back(), chr));
+	mEndOfWord[path.back()] = false;
 
-	for (auto it = path.rbegin(); it != path.rend(); ++it) {
-		TrieNode* node = it->first;
-		char chr = it->second;
-		if (node->children[chr]->children.empty() && !node->children[chr]->isEndOfWord) 
-			node->children.erase(chr);
-		else 
+	// unlink the states only this word used, they stay in the table until the next rebuild.
+	for (size_t ind{ path.size() - 1 }; ind > 0; ind--) {
+		const State state{ path[ind] };
+		const auto row{ mTransitions.begin() + state * mClassCount };
+		if (mEndOfWord[state] || std::find_if(row, row + mClassCount, [](State next) { return next != DeadState; }) != row + mClassCount)
 			break;
+
+		mTransitions[path[ind - 1] * mClassCount + mByteClass[static_cast<unsigned char>(word[ind - 1])]] = DeadState;
+		mUnreachableStates++;
 	}
+
+	if (mUnreachableStates > mEndOfWord.size() / 2)
+		iRebuild();
 	return true;
 }
 
 
-TrieTree::StartsWithsInstance::StartsWithsInstance(const TrieTree& trieTree) : mRootNode{ trieTree.root.get() }, mCurrentTrieNode{ trieTree.root.get() } {}
+// the range of words (sharing their first `depth` characters) whose next character is currChar, shorter words sort first.
+static std::pair<size_t, size_t> narrowWords(std::span<const std::string_view> words, size_t first, size_t last, size_t depth, char currChar) {
+	auto characterAt = [depth](std::string_view word) {
+		return word.size() > depth ? static_cast<int>(static_cast<unsigned char>(word[depth])) : -1;
+		};
+	const auto narrowed{ std::ranges::equal_range(words.begin() + first, words.begin() + last, static_cast<int>(static_cast<unsigned char>(currChar)), std::less{}, characterAt) };
+	return { static_cast<size_t>(narrowed.begin() - words.begin()), static_cast<size_t>(narrowed.end() - words.begin()) };
+}
+
+bool KeywordOverlay::contains(std::string_view word) const {
+	for (const KeywordOverlay* overlay{ this }; overlay; overlay = overlay->Parent) {
+		if (std::ranges::binary_search(overlay->Words, word))
+			return true;
+	}
+	return false;
+}
+
+bool KeywordOverlay::startsWith(std::string_view prefix) const {
+	for (const KeywordOverlay* overlay{ this }; overlay; overlay = overlay->Parent) {
+		const auto wordIt{ std::ranges::lower_bound(overlay->Words, prefix) };
+		if (wordIt != overlay->Words.end() && wordIt->starts_with(prefix))
+			return true;
+	}
+	return false;
+}
+
+TrieTree::StartsWithsInstance::StartsWithsInstance(const TrieTree& trieTree, const KeywordOverlay* overlay) :
+	mTrieTree{ &trieTree }, mOverlay{ overlay }, mCurrentState{ RootState } {
+	for (; overlay; overlay = overlay->Parent)
+		mOverlayRanges.emplace_back(WordRange{ 0, overlay->Words.size() });
+}
+
+bool TrieTree::StartsWithsInstance::iOverlayAccepts(char currChar) const {
+	size_t ind{ 0 };
+	for (const KeywordOverlay* overlay{ mOverlay }; overlay; overlay = overlay->Parent, ind++) {
+		const auto [first, last] { narrowWords(overlay->Words, mOverlayRanges[ind].First, mOverlayRanges[ind].Last, mInsertedCount, currChar) };
+		if (first != last)
+			return true;
+	}
+	return false;
+}
+
+void TrieTree::StartsWithsInstance::iNarrowOverlay(char currChar) {
+	size_t ind{ 0 };
+	for (const KeywordOverlay* overlay{ mOverlay }; overlay; overlay = overlay->Parent, ind++) {
+		const auto [first, last] { narrowWords(overlay->Words, mOverlayRanges[ind].First, mOverlayRanges[ind].Last, mInsertedCount, currChar) };
+		mOverlayRanges[ind] = WordRange{ first, last };
+	}
+	mInsertedCount++;
+}
 
 bool TrieTree::StartsWithsInstance::insertChar(const char currChar) {
-	if (!mCurrentTrieNode->children.contains(currChar)) {
+	const State nextState{ mTrieTree->iNextState(mCurrentState, currChar) };
+	if (nextState == DeadState && !(mOverlay && iOverlayAccepts(currChar))) {
 		mResult = false;
 		return false;
 	}
-	mCurrentTrieNode = mCurrentTrieNode->children[currChar].get();
+	if (mOverlay)
+		iNarrowOverlay(currChar);
+	mCurrentState = nextState;
 	mResult = true;
 	return true;
 }
 
 bool TrieTree::StartsWithsInstance::previewInsertChar(const char currChar) {
-	if (!mCurrentTrieNode->children.contains(currChar)) {
+	if (mTrieTree->iNextState(mCurrentState, currChar) == DeadState && !(mOverlay && iOverlayAccepts(currChar))) {
 		mResult = false;
 		return false;
 	}
@@ -82,5 +187,16 @@ bool TrieTree::StartsWithsInstance::getResult() const {
 }
 
 void TrieTree::StartsWithsInstance::reset() {
-	mCurrentTrieNode = mRootNode;
-}
\ No newline at end of file
+	mCurrentState = RootState;
+	if (!mOverlay)
+		return;
+
+	mInsertedCount = 0;
+	size_t ind{ 0 };
+	for (const KeywordOverlay* overlay{ mOverlay }; overlay; overlay = overlay->Parent, ind++)
+		mOverlayRanges[ind] = WordRange{ 0, overlay->Words.size() };
+}
+
+bool TrieTree::StartsWithsInstance::isReset() const {
+	return mCurrentState == RootState && !mInsertedCount;
+}